@@ -17,7 +17,19 @@
   
  ***************************************************************************/
 #include <fs.h>                   //this needs to be first, or it all crashes and burns...
+#include <LittleFS.h>
 #import "index.h"
+#include "cbor.h"
+#include "metrics.h"
+#include "config.h"
+#include "bootprofile.h"
+#include "scheduler.h"
+#include "latency.h"
+#include "logger.h"
+#include "heapmonitor.h"
+#include "level.h"
+#include "storage.h"
+#include "page.h"
 
 #include <ESP8266WiFi.h>          //https://github.com/esp8266/Arduino
 
@@ -25,11 +37,13 @@
 #include <DNSServer.h>
 #include <ESP8266WebServer.h>
 #include "src/WiFiManager.h" 
+#include "src/StaticAssets.h"
 
 #include <ArduinoJson.h>          //https://github.com/bblanchon/ArduinoJson
 #include <PubSubClient.h>
 #include <base64.h>
 #include <ESP8266HTTPClient.h>
+#include <Updater.h>
 
 #include <WiFiClientSecure.h>
 
@@ -38,8 +52,6 @@
 
 Adafruit_VL53L0X lox = Adafruit_VL53L0X();
 
-int resetState = 0;
-
 WiFiClient espClient;
 HTTPClient http; 
 PubSubClient client(espClient);
@@ -47,188 +59,134 @@ PubSubClient client(espClient);
 WiFiManager wifiManager;
 ESP8266WebServer server(80);
 
-bool firstLoop = true;
-unsigned long previousMillis = 0;       
+unsigned long lastReconnectAttempt = 0; //0 means connect on the next loop
+
+#define MQTT_RETRY_INTERVAL 5000
+#define MQTT_SOCKET_TIMEOUT 3           //seconds PubSubClient waits for the broker
+#define HTTP_CLIENT_TIMEOUT 3000        //ms the openHAB / Domoticz requests may take
 
 String currentFirmwareVersion = "0.1.0" ;
 
 DNSServer dnsServer; //Needed for captive portal when device is already connected to a wifi network
 
-//extra parameters
-char mqtt_server[40];
-char mqtt_port[6] ;
-char mqtt_username[40];
-char mqtt_password[40];
-char mqtt_topic[40];
+Metrics metrics;                       //runtime counters, exposed on /metrics
+BootProfile bootProfile;               //boot phase timestamps, exposed on /api/boot
+LatencyProfile latency;                //loop and blocking section timings, exposed on /api/latency
+LogBuffer logBuffer;                   //recent log output, drained to serial and exposed on /api/log
+uint8_t logLevel = LOG_LEVEL;
+HeapStats heapStats;                   //heap low-water marks, exposed on /api/heap
+FS& fileSystem = LittleFS;             //settings are stored on LittleFS, see storage.ino
+WiFiEventHandler wifiConnectedHandler;  //WiFi telemetry, see metrics.ino
+WiFiEventHandler wifiGotIpHandler;
+WiFiEventHandler wifiDisconnectedHandler;
+
+//extra parameters, stored as one binary record (see config.h), the names below refer into it
+ConfigRecord config __attribute__((aligned(4)));    //aligned for RTC memory access
+static_assert(RTC_CONFIG_OFFSET + sizeof(ConfigRecord) / 4 <= WM_FAST_CONNECT_RTC_OFFSET, "config overlaps the WiFi fast reconnect cache in RTC memory");
+
+#define CONFIG_FIELD_REFERENCE(name, size, type, label, help) char (&name)[size] = config.name;
+CONFIG_FIELDS(CONFIG_FIELD_REFERENCE)
+
 char mqtt_distance_topic[49];
 char mqtt_status[60] = "unknown";
 
-char dz_idx[5];
-char oh_itemid[40];
-char min_range[5];
-char max_range[5];
+//publish every measurement as one binary (CBOR) record on <mqtt_topic>_cbor next to the plain text topics
+#define MQTT_CBOR_PAYLOAD true
 
 float lastMeasure = 0;
+float lastPercentage = 0;
+int lastRangeStatus = -1;               //VL53L0X RangeStatus of the last measurement, -1 before the first one
+unsigned long lastMeasurementMillis = 0;
 
 //flag for saving data
 bool shouldSaveConfig = false;
-bool apstarted = false;
 
 //callback notifying us of the need to save config
 void saveConfigCallback () {
-  Serial.println("Should save config");
+  LOG_INFO("Should save config");
   shouldSaveConfig = true;
 }
 
 
 void saveSettings() {
-  Serial.println("Handling webserver request savesettings");
-
-  //store the updates values in the json config file
-    DynamicJsonBuffer jsonBuffer;
-    JsonObject& json = jsonBuffer.createObject();
-    json["mqtt_server"] = server.arg("mqtt_server");
-    json["mqtt_port"] = server.arg("mqtt_port");
-    json["mqtt_username"] = server.arg("mqtt_username");
-    json["mqtt_password"] = server.arg("mqtt_password");
-    json["mqtt_topic"] = server.arg("mqtt_topic");
-
-    json["dz_idx"] = server.arg("dz_idx");
-    json["oh_itemid"] = server.arg("oh_itemid");
-
-    json["min_range"] = server.arg("min_range");
-    json["max_range"] = server.arg("max_range");
-   
-    File configFile = SPIFFS.open("/config.json", "w");
-    if (!configFile) {
-      Serial.println("failed to open config file for writing");
+  HEAP_SITE("save_settings");
+  LOG_DEBUG("Handling webserver request savesettings");
+
+    //check everything first so a bad value does not leave a half applied update
+    for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+      if (!configValueValid(configFields[i], server.arg(configFields[i].key).c_str())) {
+        server.send(400, "text/html", "Invalid value for " + String(configFields[i].label) + ". You will be redirected to the configuration page in 5 seconds <meta http-equiv=\"refresh\" content=\"5; url=/\" />");
+        return;
+      }
     }
 
-    json.printTo(Serial);
-    json.printTo(configFile);
-    configFile.close();
-
     //put updated parameters into memory so they become effective immediately
-    server.arg("mqtt_server").toCharArray(mqtt_server,40);
-    server.arg("mqtt_port").toCharArray(mqtt_port,40);
-    server.arg("mqtt_username").toCharArray(mqtt_username,40);
-    server.arg("mqtt_password").toCharArray(mqtt_password,40);
-    server.arg("mqtt_topic").toCharArray(mqtt_topic,40);
-    server.arg("dz_idx").toCharArray(dz_idx,40);
-    server.arg("oh_itemid").toCharArray(oh_itemid,40);
-
-    server.arg("min_range").toCharArray(min_range,40);
-    server.arg("max_range").toCharArray(max_range,40);
+    for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+      setConfigValue(configFields[i], server.arg(configFields[i].key).c_str());
+    }
+
+    //store the updated values, the flash write is done from the loop
+    requestConfigSave();
+    invalidateStatus();
    
     server.send(200, "text/html", "Settings have been saved. You will be redirected to the configuration page in 5 seconds <meta http-equiv=\"refresh\" content=\"5; url=/\" />");
     
-    //mqtt settings might have changed, let's reconnect to the mqtt server if one is configured
+    //mqtt settings might have changed, let the loop reconnect to the mqtt server if one is configured
     if (strlen(mqtt_topic) != 0){
-      Serial.println("mqtt topic set, need to connect");
-      reconnect();
+      LOG_INFO("mqtt topic set, need to connect");
+      requestMqttReconnect();
     }
 }
 
-
 void setup() {
  
   Serial.begin(115200);
-  Serial.println();
-  Serial.println("Salt sentry");
-  Serial.println("Firmware version: " + currentFirmwareVersion);
+  LOG_INFO("Salt sentry");
+  LOG_INFO("Firmware version: %s", currentFirmwareVersion.c_str());
+  bootMark(BOOT_SERIAL);
+  setupLatency();
 
-  pinMode(12, INPUT_PULLUP); // config switch
+  setupButton(); // config switch
  
-  //read configuration from FS json
-  Serial.println("mounting file system");
-
-  if (SPIFFS.begin()) {
-    if (SPIFFS.exists("/config.json")) {
-      //file exists, reading and loading
-      Serial.println("reading config file");
-      File configFile = SPIFFS.open("/config.json", "r");
-      if (configFile) {
-        Serial.println("opened config file");
-        size_t size = configFile.size();
-        // Allocate a buffer to store contents of the file.
-        std::unique_ptr<char[]> buf(new char[size]);
-
-        configFile.readBytes(buf.get(), size);
-        DynamicJsonBuffer jsonBuffer;
-        JsonObject& json = jsonBuffer.parseObject(buf.get());
-        if (json.success()) {
-          Serial.println("parsed config file json");
-
-          strcpy(mqtt_server, json["mqtt_server"]);
-          strcpy(mqtt_port, json["mqtt_port"]);
-          strcpy(mqtt_username, json["mqtt_username"]);
-          strcpy(mqtt_password, json["mqtt_password"]);
-          strcpy(mqtt_topic, json["mqtt_topic"]);
-
-          strcpy(dz_idx, json["dz_idx"]);
-          strcpy(oh_itemid, json["oh_itemid"]);
-
-          strcpy(min_range, json["min_range"]);
-          strcpy(max_range, json["max_range"]);
-
-        } else {
-          Serial.println("failed to load json config");
-        }
-      }
-    } else {
-      Serial.println("config.json does not exist");
+  //read configuration from FS
+  LOG_INFO("mounting file system");
+
+  bool mounted = mountFileSystem();
+  bootMark(BOOT_FS_MOUNT);
+  if (mounted) {
+    if (!loadConfig()) {
+      LOG_WARN("no stored config");
     }
   } else {
-    Serial.println("failed to mount file system");
+    LOG_ERROR("failed to mount file system");
   }
   //end read
+  bootMark(BOOT_CONFIG_LOAD);
+
+  //portal fields, generated from the config schema (config.h)
+  WiFiManagerParameter* portalFields[CONFIG_FIELD_COUNT];
+  WiFiManagerParameter* portalHelp[CONFIG_FIELD_COUNT] = { };
+  for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+    const ConfigField& field = configFields[i];
+    if (field.help != nullptr) {
+      portalHelp[i] = new WiFiManagerParameter(field.help);
+      wifiManager.addParameter(portalHelp[i]);
+    }
+    //the parameter length is in characters, field.size counts the terminating 0 too
+    portalFields[i] = new WiFiManagerParameter(field.key, field.label, configValue(config, field), field.size - 1);
+    wifiManager.addParameter(portalFields[i]);
+  }
 
-  WiFiManagerParameter custom_mqtt_server("server", "ip address", mqtt_server, 40);
-  WiFiManagerParameter custom_mqtt_port("port", "port", mqtt_port, 5);
-  WiFiManagerParameter custom_mqtt_username("username", "username", mqtt_username, 40);
-  WiFiManagerParameter custom_mqtt_password("password", "password", mqtt_password, 40);
-  WiFiManagerParameter custom_mqtt_topic("topic", "mqtt topic", mqtt_topic, 40);
-
-  WiFiManagerParameter custom_dz_idx("dzidx", "Domoticz idx", dz_idx, 5);
-  WiFiManagerParameter custom_oh_itemid("ohitemid", "OpenHAB itemId", oh_itemid, 40);
-
-  WiFiManagerParameter custom_min_range("min_range", "full distance in cm", min_range, 5);
-  WiFiManagerParameter custom_max_range("max_range", "empty distance in cm", max_range, 5);
-
-  WiFiManagerParameter custom_text("<p>Fill the folowing values with your home assistant / domoticz infromation. Username and password are optional</p>");
-  wifiManager.addParameter(&custom_text);
-
-  wifiManager.addParameter(&custom_mqtt_server);
-  wifiManager.addParameter(&custom_mqtt_port);
-  wifiManager.addParameter(&custom_mqtt_username);
-  wifiManager.addParameter(&custom_mqtt_password);
-
-  WiFiManagerParameter custom_text1("<p>Fill the folowing field with your MQTT topic for Home assistant</p>");
-  wifiManager.addParameter(&custom_text1);
-  
-  wifiManager.addParameter(&custom_mqtt_topic);
-
-  WiFiManagerParameter custom_text2("<p>Fill the folowing field with your IDX value for Domoticz</p>");
-  wifiManager.addParameter(&custom_text2);
-    
-  wifiManager.addParameter(&custom_dz_idx);
-
-  WiFiManagerParameter custom_text3("<p>Fill the folowing field with your itemId for OpenHAB</p>");
-  wifiManager.addParameter(&custom_text3);
-  wifiManager.addParameter(&custom_oh_itemid);
-
-  WiFiManagerParameter custom_text4("<p>Fill the distances from the sensor to the salt for wich the Salt sentry should consider the salt full or empty</p>");
-  wifiManager.addParameter(&custom_text4);
-  wifiManager.addParameter(&custom_min_range);
-  wifiManager.addParameter(&custom_max_range);
+  LOG_DEBUG("WifiManager config done");
 
-  Serial.println("WifiManager config done");
+  setupWifiTelemetry();
 
   //fetches ssid and pass and tries to connect
   //if it does not connect it starts an access point with the specified name
   //and goes into a blocking loop awaiting configuration      
   if (!wifiManager.autoConnect("saltSentry")) {
-    Serial.println("failed to connect and hit timeout");
+    LOG_ERROR("failed to connect and hit timeout");
+    logFlush();
     delay(3000);
     //reset and try again
     ESP.reset();
@@ -236,256 +194,270 @@ void setup() {
   }
 
   //if you get here you have connected to the WiFi
-  Serial.println("connected to wifi network");
+  LOG_INFO("connected to wifi network");
+  bootMark(BOOT_WIFI_CONNECT);
 
   //Define url's for webserver 
   server.on("/saveSettings", saveSettings);
   server.on("/", handleRoot);
+  server.on("/api/status", HTTP_GET, handleApiStatus);
+  server.on("/api/config", HTTP_GET, handleApiConfig);
+  server.on("/api/config", HTTP_POST, handleApiConfigUpdate);
+  server.on("/metrics", HTTP_GET, handleMetrics);
+  server.on("/api/boot", HTTP_GET, handleBootProfile);
+  server.on("/api/latency", HTTP_GET, handleLatency);
+  server.on("/api/latency", HTTP_DELETE, handleLatencyReset);
+  server.on("/api/log", HTTP_GET, handleLog);
+  server.on("/api/log", HTTP_POST, handleLogLevel);
+  server.on("/api/heap", HTTP_GET, handleHeap);
+  server.on("/api/ota", HTTP_GET, handleOta);
+  server.on("/api/ota", HTTP_POST, handleOtaCheck);
+  server.on("/events", HTTP_GET, handleEvents);
+  server.on("/api/calibrate", HTTP_POST, handleCalibrate);
+  registerStaticAssets(server);
   server.onNotFound([]() {
     handleRoot();
   });
   server.begin();
+  bootMark(BOOT_WEB_SERVER);
 
   //read updated parameters
-  strcpy(mqtt_server, custom_mqtt_server.getValue());
-  strcpy(mqtt_port, custom_mqtt_port.getValue());
-  strcpy(mqtt_username, custom_mqtt_username.getValue());
-  strcpy(mqtt_password, custom_mqtt_password.getValue());
-  strcpy(mqtt_topic, custom_mqtt_topic.getValue());
-
-  strcpy(dz_idx, custom_dz_idx.getValue());
-  strcpy(oh_itemid, custom_oh_itemid.getValue());
-  strcpy(min_range, custom_min_range.getValue());
-  strcpy(max_range, custom_max_range.getValue());
+  for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+    if (!portalFields[i]->isValueTruncated() && configValueValid(configFields[i], portalFields[i]->getValue())) {
+      setConfigValue(configFields[i], portalFields[i]->getValue());
+    } else {
+      LOG_WARN("ignoring invalid portal value for %s", configFields[i].key);
+    }
+    delete portalFields[i];
+    delete portalHelp[i];
+  }
 
   //save the custom parameters to FS
   if (shouldSaveConfig) {
-    Serial.println("saving config");
-    DynamicJsonBuffer jsonBuffer;
-    JsonObject& json = jsonBuffer.createObject();
-    json["mqtt_server"] = mqtt_server;
-    json["mqtt_port"] = mqtt_port;
-    json["mqtt_username"] = mqtt_username;
-    json["mqtt_password"] = mqtt_password;
-    json["mqtt_topic"] = mqtt_topic;
-    json["dz_idx"] = dz_idx;
-    json["oh_itemid"] = oh_itemid;
-    json["min_range"] = min_range;
-    json["max_range"] = max_range;
-
-    File configFile = SPIFFS.open("/config.json", "w");
-    if (!configFile) {
-      Serial.println("failed to open config file for writing");
-    }
-
-    json.printTo(Serial);
-    json.printTo(configFile);
-    configFile.close();
-    //end save
+    LOG_INFO("saving config");
+    saveConfig();
   }
+  bootMark(BOOT_CONFIG_SAVE);
 
   //MQTT
   client.setServer(mqtt_server, atoi(mqtt_port));
+  client.setSocketTimeout(MQTT_SOCKET_TIMEOUT);
+  http.setTimeout(HTTP_CLIENT_TIMEOUT);
+  espClient.setTimeout(HTTP_CLIENT_TIMEOUT);
+  bootMark(BOOT_MQTT_SETUP);
 
-  Serial.println("Salt sentry ip on " + WiFi.SSID() + ": " + WiFi.localIP().toString()); 
+  LOG_INFO("Salt sentry ip on %s: %s", WiFi.SSID().c_str(), WiFi.localIP().toString().c_str());
 
   //Initialize time of flight sensor
   Wire.begin(2,14);
   if (!lox.begin(false, &Wire)) {
-    Serial.println(F("Failed to boot VL53L0X"));
+    LOG_ERROR("Failed to boot VL53L0X");
+    logFlush();
     delay(100000);
   }  
-  Serial.println("VL53L0X booted");
+  LOG_INFO("VL53L0X booted");
+  bootMark(BOOT_SENSOR);
+
+  setupTasks();
+  setupOta();
+  if (scheduler.overflow) {
+    LOG_ERROR("more than %d scheduler tasks, raise SCHEDULER_MAX_TASKS", SCHEDULER_MAX_TASKS);
+  }
 }
 
 
+//Update the connection status shown on the config page and in the api
+void setMqttStatus(bool connected) {
+  if (connected) {
+    strcpy(mqtt_status, "<div style=\"color:green;float:left\">connected</div>");
+  } else {
+    strcpy(mqtt_status, "<div style=\"color:red;float:left\">connection failed</div>");
+  }
+  invalidateStatus();
+
+  static int previous = -1;
+  if (previous != connected) {
+    previous = connected;
+    sseMqttStatus(connected);
+  }
+}
+
 //MQTT reconnect function
+//makes a single attempt, the loop retries every MQTT_RETRY_INTERVAL so the web server
+//and the measurements keep running while the mqtt server is unreachable
 void reconnect() {
+  PROBE_SECTION(SECTION_MQTT_RECONNECT);
+  lastReconnectAttempt = millis();
   client.disconnect();
   client.setServer(mqtt_server, atoi(mqtt_port));
-  Serial.print("Attempting MQTT connection to ");
-  Serial.print(mqtt_server);
-  Serial.print(" on port ");
-  Serial.print(mqtt_port);
-  Serial.print("...");
+  LOG_INFO("Attempting MQTT connection to %s on port %s...", mqtt_server, mqtt_port);
   
   if (client.connect("SaltSentry", mqtt_username, mqtt_password)) {
-     Serial.println("connected");
-     String("<div style=\"color:green;float:left\">connected</div>").toCharArray(mqtt_status,60);
+     LOG_INFO("mqtt connected");
+     metrics.mqttReconnects++;
+     setMqttStatus(true);
    } else {
-     Serial.print("failed, rc=");
-     String("<div style=\"color:red;float:left\">connection failed</div>").toCharArray(mqtt_status,60);
-     Serial.print(client.state());
-     Serial.println(" try again in 5 seconds");
-
-  
-
-    unsigned long previousMillis1 = 0;
-
-     //connection failed, Go into a (non-blocking) loop until we are connected 
-     while (!client.connected()) {
-        resetstate();
-         server.handleClient();  //call to handle webserver connection needed, because the while loop will block the processor
-         unsigned long currentMillis1 = millis();
-         if(currentMillis1 - previousMillis1 >= 5000) {
-         previousMillis1 = currentMillis1;
-         Serial.print("Attempting MQTT connection...");
-          if (client.connect("SaltSentry", mqtt_username, mqtt_password)) {
-                Serial.println("connected");
-                String("<div style=\"color:green;float:left\">connected</div>").toCharArray(mqtt_status,60);
-             } else {
-                     String("<div style=\"color:red;float:left\">connection failed</div>").toCharArray(mqtt_status,60);
-                Serial.print("failed, rc=");
-                Serial.print(client.state());
-                Serial.println(" try again in 5 seconds");
-             }
-         }
-      }
+     setMqttStatus(false);
+     LOG_WARN("mqtt connection failed, rc=%d try again in 5 seconds", client.state());
    }
 }
 
-long lastMsg = 0;
+//Drop the mqtt connection, the loop reconnects right away with the current settings
+void requestMqttReconnect() {
+  client.disconnect();
+  lastReconnectAttempt = 0;
+}
 
-//Initialize a reset if pin 12 is low
-void resetstate (){
-   resetState = digitalRead(12);
-   if (resetState == LOW){
-    Serial.println("It seems someone wants to go for a reset...");
-  
-    int count = 0;
+//The work of the loop, every piece is a scheduler task with its own deadline (see scheduler.h)
+#define MEASUREMENT_INTERVAL 300000     //ms between measurements
+#define ACCESS_POINT_TIMEOUT 300000     //ms the "Salt sentry online" access point stays up
+#define SLICE_BUDGET_US      20000      //time one loop() may spend on due tasks
+
+Scheduler scheduler;
+
+Task buttonTask      = { "button",       buttonLoop,          PRIORITY_HIGH };
+Task mqttTask        = { "mqtt",         serviceMqtt,         PRIORITY_HIGH };
+Task webTask         = { "web",          serviceWeb,          PRIORITY_NORMAL };
+Task dnsTask         = { "dns",          serviceDns,          PRIORITY_NORMAL };
+Task eventsTask      = { "events",       eventsLoop,          PRIORITY_NORMAL };
+Task measureTask     = { "measure",      measureLevel,        PRIORITY_NORMAL };
+Task publishTask     = { "publish",      publishMeasurement,  PRIORITY_NORMAL };
+Task accessPointTask = { "access_point", stopAccessPoint,     PRIORITY_LOW };
+Task roamTask        = { "roam",         serviceRoaming,      PRIORITY_LOW };
+Task telemetryTask   = { "telemetry",    wifiTelemetryLoop,   PRIORITY_LOW };
+Task configTask      = { "config",       configLoop,          PRIORITY_LOW };
+Task logTask         = { "log",          logDrain,            PRIORITY_LOW };
+Task heapTask        = { "heap",         heapSample,          PRIORITY_LOW };
+
+void setupTasks() {
+  scheduler.every(buttonTask, 20, 0);
+  scheduler.every(mqttTask, 10, 0);
+  scheduler.every(webTask, 10, 0);
+  scheduler.every(dnsTask, 10, 0);
+  scheduler.every(eventsTask, 50, 0);
+  scheduler.every(measureTask, MEASUREMENT_INTERVAL, 0);
+  scheduler.every(roamTask, 1000, 1000);
+  scheduler.every(telemetryTask, 1000, 0);
+  scheduler.every(configTask, 500, 500);
+  scheduler.every(logTask, 10, 0);
+  scheduler.every(heapTask, HEAP_SAMPLE_INTERVAL, 0);
+  scheduler.track(publishTask);
+  scheduler.track(accessPointTask);
+}
 
-    //See if they still want to go for a factory reset
-    while (count < 25 && digitalRead(12) == LOW) {
-      delay(100);                                           
-      count ++;
-    }
-  
-    resetState = digitalRead(12);
-    //See if they still want to go for it
-    if (resetState == LOW){
-       Serial.println("Let's do it");
-       Serial.println("we should not get here :(");
-       SPIFFS.format();
-       wifiManager.resetSettings();
-       delay(500);
-       ESP.restart();  
-    } else {
-      Serial.println("They chickened out...");
-      Serial.println("Starting AP that can be used to obtain IP");
+long lastMsg = 0;
 
-      boolean result = false;
-      while (result == false){
-        result = WiFi.softAP("Salt sentry online" );  
-      }
-      
-      if(result == true)
-      {
-        dnsServer.start(53, "*", WiFi.softAPIP());
-          
-        apstarted = true;
-        previousMillis =  millis();
-        Serial.println("AP IP address: " +  WiFi.softAPIP().toString());
-      }
+void serviceMqtt() {
+  if (strlen(mqtt_topic) != 0){
+     //try to reconnect to mqtt server if connection is lost
+    if (!client.connected() && (lastReconnectAttempt == 0 || millis() - lastReconnectAttempt >= MQTT_RETRY_INTERVAL)) { 
+      reconnect();
     }
+    PROBE_SECTION(SECTION_MQTT_LOOP);
+    HEAP_SITE("mqtt_loop");
+    client.loop();
   }
 }
 
-float calculatePercentage(float distanceCm, String minRange, String maxRange) {  
-  float percentage;
-  float rangeCm = distanceCm;
-  float correctedRange = rangeCm - minRange.toFloat();
+void serviceWeb() {
+  PROBE_SECTION(SECTION_HANDLE_CLIENT);
+  HEAP_SITE("web");
+  server.handleClient();
+}
 
-  if (correctedRange < 0) {
-      percentage = 100;
-  } else {
-     percentage = (correctedRange / ((maxRange.toFloat()-minRange.toFloat()) / 100));
-     if (percentage > 100) {
-      percentage = 0;
-     } else {
-      percentage = 100 - percentage;
-     }
-  }
+void serviceDns() {
+  dnsServer.processNextRequest();
+}
 
-  // 1 decimal
-  percentage = percentage * 10;
-  return round(percentage)/10;
+void serviceRoaming() {
+  wifiManager.roam();
 }
 
+//The access point started from the button is stopped again after ACCESS_POINT_TIMEOUT
+void stopAccessPoint() {
+  LOG_INFO("Stopping the AP, 5 minutes are past!");
+  WiFi.softAPdisconnect(false);
+}
 
-void loop() {
+void measureLevel() {
+  VL53L0X_RangingMeasurementData_t measure;
+  unsigned long measureStart = millis();
+  {
+    PROBE_SECTION(SECTION_RANGING);
+    lox.rangingTest(&measure, false);
+  }
+  metrics.measurement(millis() - measureStart, measure.RangeStatus);
+  bootMark(BOOT_FIRST_MEASUREMENT);
 
-  //if a AP is started, kill it after 3 minutes
-  if (apstarted == true){
-    unsigned long currentMillis = millis();
-    if (currentMillis - previousMillis >= 300000) {
-      previousMillis = currentMillis;
-      Serial.println("Stopping the AP, 3 minutes are past!");
-      WiFi.softAPdisconnect(false);
-      apstarted = false;    
+  // If we're measuring a slightly lower numer of mm than before, cummunicate the last measurment 
+  float percentage;
+  if (measure.RangeStatus != 4) {
+    LOG_DEBUG("range %u mm", measure.RangeMilliMeter);
+    float measurement = measure.RangeMilliMeter;
+    measurement = measurement / 10;
+    
+    if (measurement >= lastMeasure || lastMeasure - measurement > 2){
+      lastMeasure = measurement;
     }
+    
+    percentage = calculatePercentage(lastMeasure, atof(min_range), atof(max_range));
+  } else {
+    LOG_WARN("meaurment out of range, returning 100%%");
+    percentage = 100;
   }
- 
-  resetstate();
-  
+
+  lastPercentage = percentage;
+  lastRangeStatus = measure.RangeStatus;
+  lastMeasurementMillis = millis();
+  invalidateStatus();
+  sseMeasurement(percentage, lastMeasure, measure.RangeStatus);
+
+  scheduler.once(publishTask, 0);
+}
+
+//Send the last measurement to every configured sink
+void publishMeasurement() {
   if (strlen(mqtt_topic) != 0){
-     //try to reconnect to mqtt server if connection is lost
-    if (!client.connected()) { 
-      reconnect();
+    LOG_DEBUG("Sending MQTT message");
+    sendMqttMessage(lastPercentage, lastMeasure);
+    if (MQTT_CBOR_PAYLOAD) {
+      sendMqttBinaryMessage(lastPercentage, lastMeasure, lastRangeStatus);
     }
-    client.loop();
+    sendMqttWifiStats();
+    sendMqttLatency();
+    sendMqttHeap();
   }
-  
-  server.handleClient();
-  dnsServer.processNextRequest();
-  
-  resetState = digitalRead(12);
 
-  //Go into a non-blocking loop to do a measurement every 5 minutes
-  float percentage;
-  unsigned long currentMillis = millis();
-  
-    if (currentMillis - previousMillis >= 300000 || firstLoop == true) {
-      firstLoop = false;
-      previousMillis = currentMillis;
-
-      VL53L0X_RangingMeasurementData_t measure;
-      lox.rangingTest(&measure, false);      
-
-      // If we're measuring a slightly lower numer of mm than before, cummunicate the last measurment 
-      float currentMeasure;
-      if (measure.RangeStatus != 4) {
-        Serial.println(measure.RangeMilliMeter);
-        float measurement = measure.RangeMilliMeter;
-        measurement = measurement / 10;
-        
-        if (measurement < lastMeasure && lastMeasure - measurement <= 2){
-          
-          currentMeasure = lastMeasure;
-        } else {
-          currentMeasure = measurement;
-          lastMeasure = measurement;
-        }
-        
-        percentage = calculatePercentage(currentMeasure, min_range, max_range);
-      } else {
-        Serial.println("meaurment out of range, returning 100%");
-        percentage = 100;
-      }
+  if (strlen(dz_idx) != 0){
+    sendDomoticzMessage(lastPercentage, lastMeasure);
+  }
 
-      
-      
-      if (strlen(mqtt_topic) != 0){
-        Serial.println("Sending MQTT message");
-        sendMqttMessage(percentage, currentMeasure);
-      }
-    
-     if (strlen(dz_idx) != 0){
-      sendDomoticzMessage(percentage, currentMeasure);
-     }
-   
-     // OpenHAB
-     if (strlen(oh_itemid) != 0){
-       sendOpenHabMessage(percentage, currentMeasure);
-      }
+  // OpenHAB
+  if (strlen(oh_itemid) != 0){
+    sendOpenHabMessage(lastPercentage, lastMeasure);
+  }
+
+  //the publishers are the String heavy path, catch its low point too
+  heapSample();
+
+  //marked once, at the end of the first run with a successful publish
+  if (metrics.firstPublishMs != 0) {
+    bootMark(BOOT_FIRST_PUBLISH);
+    reportBootProfile();
+  }
+}
+
+void loop() {
+  unsigned long loopStart = micros();
+  uint32_t idle;
+  {
+    PROBE_LOOP();
+    idle = scheduler.runSlice(SLICE_BUDGET_US);
+  }
+  metrics.loopTime(micros() - loopStart);
+
+  //nothing due: hand the time to the SDK, which can let the modem sleep meanwhile
+  if (idle > 0) {
+    delay(idle);
   }
 }
@@ -0,0 +1,110 @@
+//Machine readable status and configuration endpoints
+
+//rssi and uptime in the cached status are refreshed at least this often (ms)
+#define STATUS_CACHE_MAX_AGE 5000
+
+//Cached /api/status response, rebuilt when a measurement, a setting or the mqtt status changes
+char statusCache[320];
+bool statusCacheValid = false;
+unsigned long statusCacheBuilt = 0;
+
+void invalidateStatus() {
+  statusCacheValid = false;
+}
+
+void buildStatus() {
+  StaticJsonBuffer<JSON_OBJECT_SIZE(10)> jsonBuffer;
+  JsonObject& json = jsonBuffer.createObject();
+  json["level"] = lastPercentage;
+  json["distance"] = lastMeasure;
+  json["sensor_status"] = lastRangeStatus;
+  json["sensor_ok"] = lastRangeStatus >= 0 && lastRangeStatus != 4;
+  if (strlen(mqtt_topic) == 0) {
+    json["mqtt"] = "disabled";
+  } else {
+    json["mqtt"] = client.connected() ? "connected" : "disconnected";
+  }
+  json["mqtt_state"] = client.state();
+  json["rssi"] = WiFi.RSSI();
+  json["uptime"] = millis() / 1000;
+  json["measured"] = lastRangeStatus >= 0 ? (millis() - lastMeasurementMillis) / 1000 : 0;
+  json["version"] = currentFirmwareVersion.c_str();
+
+  json.printTo(statusCache, sizeof(statusCache));
+  statusCacheValid = true;
+  statusCacheBuilt = millis();
+}
+
+void handleApiStatus() {
+  HEAP_SITE("api_status");
+  if (!statusCacheValid || millis() - statusCacheBuilt >= STATUS_CACHE_MAX_AGE) {
+    buildStatus();
+  }
+  server.send(200, "application/json", statusCache);
+}
+
+//Secrets are write only, only whether they are set is reported as <key>_set. The keys are constant
+//strings, ArduinoJson keeps a pointer to those instead of copying them into the json buffer
+#define CONFIG_FIELD_SET_KEY(name, size, type, label, help) #name "_set",
+static const char* const configSetKeys[] = { CONFIG_FIELDS(CONFIG_FIELD_SET_KEY) };
+
+//Longest possible /api/config response, from the schema: every value at its maximum length with every
+//character escaped, or "<key>_set":false for a secret. Static, it does not fit the stack comfortably
+#define CONFIG_FIELD_JSON_SIZE(name, size, type, label, help) + sizeof(#name "_set") + 6 + 2 * (size - 1)
+#define CONFIG_JSON_SIZE (3 CONFIG_FIELDS(CONFIG_FIELD_JSON_SIZE))
+
+void handleApiConfig() {
+  static char response[CONFIG_JSON_SIZE];
+  StaticJsonBuffer<JSON_OBJECT_SIZE(CONFIG_FIELD_COUNT)> jsonBuffer;
+  JsonObject& json = jsonBuffer.createObject();
+  for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+    const char* value = configValue(config, configFields[i]);
+    if (configFields[i].type == CONFIG_SECRET) {
+      json[configSetKeys[i]] = strlen(value) != 0;
+    } else {
+      json[configFields[i].key] = value;
+    }
+  }
+  json.printTo(response, sizeof(response));
+  server.send(200, "application/json", response);
+}
+
+//Partial update, only the keys present in the posted json object are changed
+void handleApiConfigUpdate() {
+  DynamicJsonBuffer jsonBuffer;
+  JsonObject& json = jsonBuffer.parseObject(server.arg("plain"));
+  if (!json.success()) {
+    server.send(400, "application/json", "{\"error\":\"invalid json\"}");
+    return;
+  }
+
+  //validate everything first so a bad request does not leave a half applied update
+  for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+    const char* key = configFields[i].key;
+    if (json.containsKey(key) && !configValueValid(configFields[i], json[key].as<String>().c_str())) {
+      server.send(400, "application/json", "{\"error\":\"invalid value\",\"key\":\"" + String(key) + "\"}");
+      return;
+    }
+  }
+
+  bool mqttChanged = false;
+  for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+    const char* key = configFields[i].key;
+    if (json.containsKey(key) && setConfigValue(configFields[i], json[key].as<String>().c_str())) {
+      if (strncmp(key, "mqtt_", 5) == 0) {
+        mqttChanged = true;
+      }
+    }
+  }
+
+  requestConfigSave();
+  invalidateStatus();
+
+  //the loop reconnects with the new settings
+  if (mqttChanged) {
+    LOG_INFO("mqtt settings changed through the api");
+    requestMqttReconnect();
+  }
+
+  handleApiConfig();
+}
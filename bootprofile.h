@@ -0,0 +1,70 @@
+/***************************************************************************
+ Boot phase profiler of the Salt sentry.
+
+ setup() and the first loop() mark the end of every phase with a timestamp
+ from micros(), which counts from the start of the SDK. The marks are kept in
+ a fixed array; the duration of a phase is the time since the previous mark.
+ The report is published once after the first publish and served on /api/boot.
+ ***************************************************************************/
+#ifndef BOOTPROFILE_H
+#define BOOTPROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+enum BootPhase {
+  BOOT_SERIAL,              //SDK start until serial is up
+  BOOT_FS_MOUNT,
+  BOOT_CONFIG_LOAD,
+  BOOT_WIFI_CONNECT,        //WiFiManager setup and autoConnect
+  BOOT_WEB_SERVER,
+  BOOT_CONFIG_SAVE,
+  BOOT_MQTT_SETUP,
+  BOOT_SENSOR,              //Wire and VL53L0X init
+  BOOT_FIRST_MEASUREMENT,   //end of setup until the first measurement is done
+  BOOT_FIRST_PUBLISH,
+  BOOT_PHASE_COUNT
+};
+
+static const char* const bootPhaseNames[BOOT_PHASE_COUNT] = {
+  "serial", "fs_mount", "config_load", "wifi_connect", "web_server",
+  "config_save", "mqtt_setup", "sensor", "first_measurement", "first_publish"
+};
+
+struct BootProfile {
+  uint32_t markUs[BOOT_PHASE_COUNT];
+
+  //only the first mark of a phase counts
+  void mark(BootPhase phase, uint32_t nowUs) {
+    if (markUs[phase] == 0) {
+      markUs[phase] = nowUs;
+    }
+  }
+
+  bool complete() const {
+    return markUs[BOOT_PHASE_COUNT - 1] != 0;
+  }
+
+  //time spent in a phase, 0 when it has not ended yet
+  uint32_t durationUs(int phase) const {
+    if (markUs[phase] == 0) {
+      return 0;
+    }
+    return phase == 0 ? markUs[0] : markUs[phase] - markUs[phase - 1];
+  }
+
+  //json object of the phase durations in microseconds, plus "total". Returns the length,
+  //the output is cut off (and not valid json) when the buffer is too small
+  size_t report(char* buffer, size_t size) const {
+    size_t used = 0;
+    for (int i = 0; i < BOOT_PHASE_COUNT && used < size; i++) {
+      used += snprintf(buffer + used, size - used, "%c\"%s\":%lu", i == 0 ? '{' : ',', bootPhaseNames[i], (unsigned long)durationUs(i));
+    }
+    if (used < size) {
+      used += snprintf(buffer + used, size - used, ",\"total\":%lu}", (unsigned long)markUs[BOOT_PHASE_COUNT - 1]);
+    }
+    return used < size ? used : size - 1;
+  }
+};
+
+#endif
@@ -0,0 +1,41 @@
+//Boot phase markers (see bootprofile.h), reported on /api/boot and once over mqtt
+
+bool bootLogged = false;
+bool bootReported = false;              //published on <mqtt_topic>_boot
+
+void bootMark(BootPhase phase) {
+  bootProfile.mark(phase, micros());
+}
+
+void handleBootProfile() {
+  char response[320];
+  bootProfile.report(response, sizeof(response));
+  server.send(200, "application/json", response);
+}
+
+//Print the boot breakdown once after the first publish, and publish it on <mqtt_topic>_boot.
+//A publish that fails is tried again after the next measurement
+void reportBootProfile() {
+  if (bootReported || !bootProfile.complete()) {
+    return;
+  }
+  if (!bootLogged) {
+    bootLogged = true;
+    LOG_INFO("boot phases (ms):");
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+      LOG_INFO("  %-18s %8.1f", bootPhaseNames[i], bootProfile.durationUs(i) / 1000.0);
+    }
+    LOG_INFO("  %-18s %8.1f", "total", bootProfile.markUs[BOOT_PHASE_COUNT - 1] / 1000.0);
+  }
+
+  if (strlen(mqtt_topic) == 0 || !client.connected()) {
+    return;
+  }
+  char payload[320];
+  bootProfile.report(payload, sizeof(payload));
+  char topic[sizeof(mqtt_topic) + 5];
+  strcpy(topic, mqtt_topic);
+  strcat(topic, "_boot");
+  bootReported = client.publish(topic, payload, true);
+  metrics.telemetry(bootReported);
+}
@@ -0,0 +1,94 @@
+//Config button on GPIO 12, debounced from a pin change interrupt and handled by the button task without blocking.
+//A short press starts the "Salt sentry online" access point, holding it for BUTTON_LONG_PRESS_MS is a factory reset
+
+#define BUTTON_PIN           12
+#define BUTTON_DEBOUNCE_MS   30         //the level has to be stable this long after the last edge
+#define BUTTON_LONG_PRESS_MS 2500
+#define AP_START_RETRY_MS    1000
+
+enum ButtonState {
+  BUTTON_RELEASED,
+  BUTTON_PRESSED,
+  BUTTON_HELD                           //long press handled, waiting for the release
+};
+
+//set by the interrupt, every bounce moves the edge time on
+volatile bool buttonEdge = false;
+volatile uint32_t buttonEdgeMs = 0;
+
+ButtonState buttonState = BUTTON_RELEASED;
+unsigned long buttonPressedAt = 0;
+
+Task factoryResetTask     = { "factory_reset", factoryReset,     PRIORITY_HIGH };
+Task startAccessPointTask = { "start_ap",      startAccessPoint, PRIORITY_NORMAL };
+
+void IRAM_ATTR buttonInterrupt() {
+  buttonEdgeMs = millis();
+  buttonEdge = true;
+}
+
+void setupButton() {
+  scheduler.track(factoryResetTask);
+  scheduler.track(startAccessPointTask);
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), buttonInterrupt, CHANGE);
+  //a button held down during boot is handled like a press now
+  if (digitalRead(BUTTON_PIN) == LOW) {
+    buttonInterrupt();
+  }
+}
+
+//Button task: reads the pin once the bounces have settled, and times the long press while it is held
+void buttonLoop() {
+  if (buttonEdge) {
+    noInterrupts();
+    uint32_t edgeMs = buttonEdgeMs;
+    bool settled = millis() - edgeMs >= BUTTON_DEBOUNCE_MS;
+    if (settled) {
+      buttonEdge = false;
+    }
+    interrupts();
+
+    if (settled) {
+      bool pressed = digitalRead(BUTTON_PIN) == LOW;
+      if (pressed && buttonState == BUTTON_RELEASED) {
+        LOG_INFO("It seems someone wants to go for a reset...");
+        buttonState = BUTTON_PRESSED;
+        buttonPressedAt = edgeMs;
+      } else if (!pressed && buttonState != BUTTON_RELEASED) {
+        if (buttonState == BUTTON_PRESSED) {
+          LOG_INFO("They chickened out...");
+          scheduler.once(startAccessPointTask, 0);
+        }
+        buttonState = BUTTON_RELEASED;
+      }
+    }
+  }
+
+  if (buttonState == BUTTON_PRESSED && millis() - buttonPressedAt >= BUTTON_LONG_PRESS_MS) {
+    buttonState = BUTTON_HELD;
+    scheduler.once(factoryResetTask, 0);
+  }
+}
+
+void factoryReset() {
+  LOG_WARN("Let's do it, factory reset");
+  logFlush();
+  fileSystem.format();
+  wifiManager.resetSettings();
+  delay(500);
+  ESP.restart();
+}
+
+//Start the access point that can be used to obtain the ip, stopped again after ACCESS_POINT_TIMEOUT
+void startAccessPoint() {
+  LOG_INFO("Starting AP that can be used to obtain IP");
+  if (!WiFi.softAP("Salt sentry online")) {
+    LOG_WARN("failed to start the AP, trying again");
+    scheduler.once(startAccessPointTask, AP_START_RETRY_MS);
+    return;
+  }
+  dnsServer.start(53, "*", WiFi.softAPIP());
+  scheduler.once(accessPointTask, ACCESS_POINT_TIMEOUT);
+  LOG_INFO("AP IP address: %s", WiFi.softAPIP().toString().c_str());
+}
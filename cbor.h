@@ -0,0 +1,123 @@
+/***************************************************************************
+ Minimal CBOR (RFC 8949) writer for the Salt sentry telemetry record.
+
+ Only the item types the firmware needs are supported (unsigned/negative
+ integers, text strings, maps and single precision floats). Everything is
+ encoded into a buffer supplied by the caller, nothing is allocated on the
+ heap. When the buffer is too small the writer stops writing and ok()
+ returns false, so a truncated record is never published. encodeTelemetry()
+ writes the record itself, test/cbor_test.cpp decodes it again on the host.
+ ***************************************************************************/
+#ifndef CBOR_H
+#define CBOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class CborWriter {
+  public:
+    CborWriter(uint8_t *buffer, size_t size) : _buffer(buffer), _size(size), _length(0), _overflow(false) {}
+
+    void map(uint32_t pairs) {
+      head(5, pairs);
+    }
+
+    void text(const char *value) {
+      size_t length = strlen(value);
+      head(3, length);
+      bytes((const uint8_t*)value, length);
+    }
+
+    void number(uint32_t value) {
+      head(0, value);
+    }
+
+    void number(int32_t value) {
+      if (value < 0) {
+        head(1, (uint32_t)(-1 - value));
+      } else {
+        head(0, (uint32_t)value);
+      }
+    }
+
+    void number(float value) {
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      put(0xFA);
+      put(bits >> 24);
+      put(bits >> 16);
+      put(bits >> 8);
+      put(bits);
+    }
+
+    size_t length() const {
+      return _length;
+    }
+
+    bool ok() const {
+      return !_overflow;
+    }
+
+  private:
+    uint8_t *_buffer;
+    size_t   _size;
+    size_t   _length;
+    bool     _overflow;
+
+    void put(uint8_t value) {
+      if (_length < _size) {
+        _buffer[_length++] = value;
+      } else {
+        _overflow = true;
+      }
+    }
+
+    void bytes(const uint8_t *data, size_t length) {
+      for (size_t i = 0; i < length; i++) {
+        put(data[i]);
+      }
+    }
+
+    //major type in the upper 3 bits, argument encoded in the shortest form
+    void head(uint8_t major, uint32_t value) {
+      major <<= 5;
+      if (value < 24) {
+        put(major | value);
+      } else if (value <= 0xFF) {
+        put(major | 24);
+        put(value);
+      } else if (value <= 0xFFFF) {
+        put(major | 25);
+        put(value >> 8);
+        put(value);
+      } else {
+        put(major | 26);
+        put(value >> 24);
+        put(value >> 16);
+        put(value >> 8);
+        put(value);
+      }
+    }
+};
+
+//Schema version of the binary telemetry record, bump when keys are added, removed or change meaning
+#define TELEMETRY_SCHEMA_VERSION 1
+
+//One measurement as a self describing record:
+//{"v": schema, "pct": level %, "cm": distance, "st": VL53L0X range status, "up": uptime in seconds}
+inline void encodeTelemetry(CborWriter& cbor, float percentage, float distanceCm, uint8_t rangeStatus, uint32_t uptime) {
+  cbor.map(5);
+  cbor.text("v");
+  cbor.number((uint32_t)TELEMETRY_SCHEMA_VERSION);
+  cbor.text("pct");
+  cbor.number(percentage);
+  cbor.text("cm");
+  cbor.number(distanceCm);
+  cbor.text("st");
+  cbor.number((uint32_t)rangeStatus);
+  cbor.text("up");
+  cbor.number(uptime);
+}
+
+#endif
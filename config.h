@@ -0,0 +1,161 @@
+/***************************************************************************
+ Binary configuration record of the Salt sentry.
+
+ The settings are stored as one packed, versioned struct with a CRC32, so
+ booting is a single read into RAM instead of a JSON parse. A copy is kept in
+ RTC memory, which survives deep sleep, so a wakeup does not touch flash at all.
+ ***************************************************************************/
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONFIG_MAGIC   0x46435353   //"SSCF"
+#define CONFIG_VERSION 1
+
+//RTC user memory offset in 4 byte blocks, the first 32 blocks are used by eboot for OTA.
+//WiFiManager keeps its fast reconnect cache from WM_FAST_CONNECT_RTC_OFFSET (112) on
+#define RTC_CONFIG_OFFSET 32
+
+enum ConfigFieldType : uint8_t {
+  CONFIG_TEXT,                //any text
+  CONFIG_SECRET,              //text that is never reported back (api)
+  CONFIG_NUMBER,              //digits only
+  CONFIG_PORT,                //tcp port, 1-65535
+  CONFIG_URL                  //http:// url
+};
+
+/*
+ The settings schema, everything else is generated from this list: the record
+ layout, the global names, the WiFiManager portal fields, the config page
+ form, /api/config and the validation of new values.
+
+ X(name, size, type, label, help text shown above the field in the portal and on the config page)
+
+ size includes the terminating 0. New fields go at the end, a record stored by
+ firmware without them is upgraded on load (see configUpgrade).
+ */
+#define CONFIG_FIELDS(X) \
+  X(mqtt_server,   40, CONFIG_TEXT,   "ip address",           "<p>Fill the folowing values with your home assistant / domoticz infromation. Username and password are optional</p>") \
+  X(mqtt_port,      6, CONFIG_PORT,   "port",                 nullptr) \
+  X(mqtt_username, 40, CONFIG_TEXT,   "username",             nullptr) \
+  X(mqtt_password, 40, CONFIG_SECRET, "password",             nullptr) \
+  X(mqtt_topic,    40, CONFIG_TEXT,   "mqtt topic",           "<p>Fill the folowing field with your MQTT topic for Home assistant</p>") \
+  X(dz_idx,         5, CONFIG_NUMBER, "Domoticz idx",         "<p>Fill the folowing field with your IDX value for Domoticz</p>") \
+  X(oh_itemid,     40, CONFIG_TEXT,   "OpenHAB itemId",       "<p>Fill the folowing field with your itemId for OpenHAB</p>") \
+  X(min_range,      5, CONFIG_NUMBER, "full distance in cm",  "<p>Fill the distances from the sensor to the salt for wich the Salt sentry should consider the salt full or empty</p>") \
+  X(max_range,      5, CONFIG_NUMBER, "empty distance in cm", nullptr) \
+  X(ota_url,       80, CONFIG_URL,    "update manifest url",  "<p>Optional: url of the firmware update manifest, leave empty to disable updates</p>")
+
+#define CONFIG_FIELD_MEMBER(name, size, type, label, help) char name[size];
+#define CONFIG_FIELD_BYTES(name, size, type, label, help) + size
+
+//total size of the fields, used to pad the record to whole RTC memory blocks
+#define CONFIG_FIELDS_SIZE (0 CONFIG_FIELDS(CONFIG_FIELD_BYTES))
+
+struct __attribute__((packed)) ConfigRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;              //sizeof(ConfigRecord), catches layout changes without a version bump
+
+  CONFIG_FIELDS(CONFIG_FIELD_MEMBER)
+
+  uint8_t  reserved[4 - CONFIG_FIELDS_SIZE % 4];
+  uint32_t crc;               //CRC32 over everything above
+};
+
+static_assert(sizeof(ConfigRecord) % 4 == 0, "ConfigRecord must be a multiple of 4 bytes for RTC memory");
+
+struct ConfigField {
+  const char*     key;        //name in forms, json and the api
+  uint16_t        offset;     //position in ConfigRecord
+  uint8_t         size;
+  ConfigFieldType type;
+  const char*     label;
+  const char*     help;
+};
+
+#define CONFIG_FIELD_DESCRIPTOR(name, size, type, label, help) { #name, offsetof(ConfigRecord, name), size, type, label, help },
+
+static constexpr ConfigField configFields[] = { CONFIG_FIELDS(CONFIG_FIELD_DESCRIPTOR) };
+#define CONFIG_FIELD_COUNT (sizeof(configFields) / sizeof(configFields[0]))
+
+#define CONFIG_FIELD_CHECK(name, size, type, label, help) \
+  static_assert(size > 1 && size <= 255, #name ": size must fit the descriptor");
+CONFIG_FIELDS(CONFIG_FIELD_CHECK)
+
+inline char* configValue(ConfigRecord& record, const ConfigField& field) {
+  return (char*)&record + field.offset;
+}
+
+//Check a new value against the schema, empty is always allowed (the setting is not used)
+inline bool configValueValid(const ConfigField& field, const char* value) {
+  size_t length = strlen(value);
+  if (length >= field.size) {
+    return false;
+  }
+  if (length == 0 || field.type == CONFIG_TEXT || field.type == CONFIG_SECRET) {
+    return true;
+  }
+  if (field.type == CONFIG_URL) {
+    return strncmp(value, "http://", 7) == 0 && length > 7;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (value[i] < '0' || value[i] > '9') {
+      return false;
+    }
+  }
+  if (field.type == CONFIG_PORT) {
+    long port = atol(value);
+    return port >= 1 && port <= 65535;
+  }
+  return true;
+}
+
+//CRC32 (IEEE 802.3), bitwise, the record is only checked at boot and when saving
+inline uint32_t configCrc(const void* data, size_t length) {
+  const uint8_t* bytes = (const uint8_t*)data;
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= bytes[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+inline bool configValid(const ConfigRecord& record) {
+  return record.magic == CONFIG_MAGIC
+      && record.version == CONFIG_VERSION
+      && record.size == sizeof(ConfigRecord)
+      && record.crc == configCrc(&record, offsetof(ConfigRecord, crc));
+}
+
+//Accept a record of length bytes written by firmware with fewer fields. Fields are only ever
+//appended, so the stored ones are where they were and the new ones start out empty
+inline bool configUpgrade(ConfigRecord& record, size_t length) {
+  if (record.magic != CONFIG_MAGIC || record.version != CONFIG_VERSION || record.size != length
+      || length >= sizeof(ConfigRecord) || length < offsetof(ConfigRecord, mqtt_server) + sizeof(uint32_t)) {
+    return false;
+  }
+  uint32_t crc;
+  memcpy(&crc, (uint8_t*)&record + length - sizeof(crc), sizeof(crc));
+  if (crc != configCrc(&record, length - sizeof(crc))) {
+    return false;
+  }
+  memset((uint8_t*)&record + length - sizeof(crc), 0, sizeof(ConfigRecord) - length + sizeof(crc));
+  return true;
+}
+
+inline void configSeal(ConfigRecord& record) {
+  record.magic = CONFIG_MAGIC;
+  record.version = CONFIG_VERSION;
+  record.size = sizeof(ConfigRecord);
+  record.crc = configCrc(&record, offsetof(ConfigRecord, crc));
+}
+
+#endif
@@ -0,0 +1,127 @@
+//Loading and storing the binary config record (see config.h)
+
+#define CONFIG_FILE      "/config.bin"
+#define CONFIG_JSON_FILE "/config.json"   //format of firmware before 0.2, migrated on first boot
+
+//Changes are written to flash this long (ms) after the last one, so a burst of changes is one write
+#define CONFIG_SAVE_DELAY 2000
+
+bool configDirty = false;
+unsigned long configDirtySince = 0;
+uint32_t configStoredCrc = 0;        //crc of the record in flash, a save of the same record is skipped
+
+//Load the settings into config. Returns false when there is no valid stored config
+bool loadConfig() {
+  //after a deep sleep wakeup the RTC copy is still valid, no need to touch flash
+  if (ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE) {
+    ESP.rtcUserMemoryRead(RTC_CONFIG_OFFSET, (uint32_t*)&config, sizeof(config));
+    if (configValid(config)) {
+      LOG_INFO("config loaded from RTC memory");
+      configStoredCrc = config.crc;     //the flash copy is written together with the RTC copy
+      return true;
+    }
+  }
+
+  File configFile = fileSystem.open(CONFIG_FILE, "r");
+  if (configFile) {
+    size_t read = configFile.read((uint8_t*)&config, sizeof(config));
+    configFile.close();
+    if (read == sizeof(config) && configValid(config)) {
+      LOG_INFO("config loaded");
+      configStoredCrc = config.crc;
+      ESP.rtcUserMemoryWrite(RTC_CONFIG_OFFSET, (uint32_t*)&config, sizeof(config));
+      return true;
+    }
+    if (configUpgrade(config, read)) {
+      LOG_INFO("config upgraded to the current schema");
+      saveConfig();
+      return true;
+    }
+    LOG_WARN("config file is damaged or from another version, ignoring it");
+  }
+
+  memset(&config, 0, sizeof(config));
+  if (fileSystem.exists(CONFIG_JSON_FILE) && migrateJsonConfig()) {
+    return true;
+  }
+  return false;
+}
+
+//Store the current settings, in flash and in RTC memory. Blocks on the flash write,
+//request handlers use requestConfigSave instead. A failed write stays pending, configLoop
+//tries again after CONFIG_SAVE_DELAY
+void saveConfig() {
+  configSeal(config);
+  if (config.crc == configStoredCrc) {
+    configDirty = false;
+    metrics.configWritesSkipped++;
+    return;
+  }
+
+  if (!writeFileAtomic(CONFIG_FILE, (const uint8_t*)&config, sizeof(config))) {
+    configDirty = true;
+    configDirtySince = millis();
+    return;
+  }
+  configDirty = false;
+  configStoredCrc = config.crc;
+  metrics.configWrites++;
+  //only now, a wakeup must not run on settings that a reset would lose
+  ESP.rtcUserMemoryWrite(RTC_CONFIG_OFFSET, (uint32_t*)&config, sizeof(config));
+}
+
+//The settings in RAM changed and are already in effect, store them from the loop a little later
+void requestConfigSave() {
+  configDirty = true;
+  configDirtySince = millis();
+}
+
+//Called from the loop, writes pending changes once they have settled
+void configLoop() {
+  if (configDirty && millis() - configDirtySince >= CONFIG_SAVE_DELAY) {
+    LOG_INFO("saving config");
+    saveConfig();
+  }
+}
+
+//Set one setting, returns true when the value changed. The value is cut to the field size,
+//use configValueValid first to reject it instead
+bool setConfigValue(const ConfigField& field, const char* value) {
+  char* stored = configValue(config, field);
+  if (strncmp(stored, value, field.size) == 0) {
+    return false;
+  }
+  strlcpy(stored, value, field.size);
+  return true;
+}
+
+//Copy a json string into a fixed size field, truncating when needed
+void copyJsonField(JsonObject& json, const char* key, char* field, size_t size) {
+  const char* value = json[key];
+  strlcpy(field, value != NULL ? value : "", size);
+}
+
+//One time conversion of the json config file written by older firmware
+bool migrateJsonConfig() {
+  LOG_INFO("migrating config.json to the binary config format");
+  File configFile = fileSystem.open(CONFIG_JSON_FILE, "r");
+  if (!configFile) {
+    return false;
+  }
+
+  DynamicJsonBuffer jsonBuffer;
+  JsonObject& json = jsonBuffer.parseObject(configFile);
+  configFile.close();
+  if (!json.success()) {
+    LOG_ERROR("failed to load json config");
+    return false;
+  }
+
+  for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+    copyJsonField(json, configFields[i].key, configValue(config, configFields[i]), configFields[i].size);
+  }
+
+  saveConfig();
+  fileSystem.remove(CONFIG_JSON_FILE);
+  return true;
+}
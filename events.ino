@@ -0,0 +1,115 @@
+//Server-Sent Events: pushes measurements and status changes to connected browsers and integrations
+
+#define SSE_MAX_CLIENTS 3
+#define SSE_KEEPALIVE_INTERVAL 15000   //ms, a comment line keeps proxies and browsers from closing the stream
+#define CALIBRATION_INTERVAL 250       //ms between raw measurements in live calibration mode
+#define CALIBRATION_TIMEOUT 300000     //live calibration switches itself off after 5 minutes
+
+WiFiClient sseClients[SSE_MAX_CLIENTS];
+unsigned long sseLastKeepalive = 0;
+int sseLastRangeStatus = -1;
+
+bool calibrating = false;
+unsigned long calibrationStarted = 0;
+unsigned long calibrationLast = 0;
+
+//Take over the connection of the current request and keep it open as an event stream
+void handleEvents() {
+  int slot = -1;
+  for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (!sseClients[i].connected()) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == -1) {
+    server.send(503, "text/plain", "too many event listeners");
+    return;
+  }
+
+  LOG_INFO("Event listener connected from %s", server.client().remoteIP().toString().c_str());
+
+  server.client().setNoDelay(true);
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendContent_P(PSTR("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nConnection: keep-alive\r\nCache-Control: no-cache\r\nAccess-Control-Allow-Origin: *\r\n\r\nretry: 5000\n\n"));
+  sseClients[slot] = server.client();
+}
+
+//Start or stop live calibration: POST /api/calibrate?on=1
+void handleCalibrate() {
+  calibrating = server.arg("on") == "1";
+  calibrationStarted = millis();
+  LOG_INFO("Live calibration %s", calibrating ? "started" : "stopped");
+  server.send(200, "application/json", calibrating ? "{\"calibrating\":true}" : "{\"calibrating\":false}");
+}
+
+int sseListeners() {
+  int count = 0;
+  for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (sseClients[i].connected()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void sseBroadcast(const char* event, const char* data) {
+  for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+    if (sseClients[i].connected()) {
+      sseClients[i].printf_P(PSTR("event: %s\ndata: %s\n\n"), event, data);
+    }
+  }
+}
+
+//New measurement from the loop, also reports sensor status changes
+void sseMeasurement(float percentage, float distanceCm, int rangeStatus) {
+  char data[80];
+  snprintf_P(data, sizeof(data), PSTR("{\"level\":%.1f,\"distance\":%.1f,\"status\":%d}"), percentage, distanceCm, rangeStatus);
+  sseBroadcast("measurement", data);
+
+  if (rangeStatus != sseLastRangeStatus) {
+    snprintf_P(data, sizeof(data), PSTR("{\"status\":%d,\"ok\":%s}"), rangeStatus, rangeStatus != 4 ? "true" : "false");
+    sseBroadcast("sensor", data);
+    sseLastRangeStatus = rangeStatus;
+  }
+}
+
+void sseMqttStatus(bool connected) {
+  sseBroadcast("mqtt", connected ? "{\"connected\":true}" : "{\"connected\":false}");
+}
+
+//Called from the loop: keepalives and the raw measurements of live calibration mode
+void eventsLoop() {
+  unsigned long now = millis();
+
+  if (now - sseLastKeepalive >= SSE_KEEPALIVE_INTERVAL) {
+    sseLastKeepalive = now;
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+      if (sseClients[i].connected()) {
+        sseClients[i].write(":\n\n", 3);
+      }
+    }
+  }
+
+  if (!calibrating) {
+    return;
+  }
+  if (now - calibrationStarted >= CALIBRATION_TIMEOUT || sseListeners() == 0) {
+    LOG_INFO("Live calibration stopped");
+    calibrating = false;
+    return;
+  }
+  if (now - calibrationLast < CALIBRATION_INTERVAL) {
+    return;
+  }
+  calibrationLast = now;
+
+  VL53L0X_RangingMeasurementData_t measure;
+  lox.rangingTest(&measure, false);
+  float distanceCm = measure.RangeMilliMeter / 10.0;
+
+  char data[96];
+  snprintf_P(data, sizeof(data), PSTR("{\"mm\":%u,\"status\":%u,\"level\":%.1f,\"distance\":%.1f}"),
+             measure.RangeMilliMeter, measure.RangeStatus, calculatePercentage(distanceCm, atof(min_range), atof(max_range)), distanceCm);
+  sseBroadcast("raw", data);
+}
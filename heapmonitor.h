@@ -0,0 +1,123 @@
+/***************************************************************************
+ Heap health monitor of the Salt sentry.
+
+ The heap is sampled periodically: free bytes, largest free block and the
+ fragmentation percentage reported by the core, with the low-water marks
+ since boot. A device whose largest block keeps shrinking over the weeks is
+ fragmenting, even when the free total looks fine.
+
+ Debug builds with HEAP_SITE_TRACKING 1 also account the heap per call site.
+ A HEAP_SITE("name") at the top of a block (the String and new heavy paths)
+ records on every exit how many bytes the block left allocated and whether
+ it shrank the largest free block. The String buffers come from the core's
+ malloc, which a sketch cannot hook, so the accounting is by heap deltas
+ rather than by counting the calls. Without HEAP_SITE_TRACKING the tags
+ compile to nothing.
+ ***************************************************************************/
+#ifndef HEAPMONITOR_H
+#define HEAPMONITOR_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifndef HEAP_SITE_TRACKING
+#define HEAP_SITE_TRACKING 0
+#endif
+
+#define HEAP_SAMPLE_INTERVAL 5000       //ms
+#define HEAP_SITE_MAX        16
+
+struct HeapStats {
+  uint32_t samples;
+  uint32_t free;
+  uint32_t freeMin;
+  uint32_t maxBlock;
+  uint32_t maxBlockMin;
+  uint8_t  fragmentation;               //percent
+  uint8_t  fragmentationMax;
+
+  void sample(uint32_t freeBytes, uint32_t block, uint8_t fragmented) {
+    if (samples == 0 || freeBytes < freeMin) {
+      freeMin = freeBytes;
+    }
+    if (samples == 0 || block < maxBlockMin) {
+      maxBlockMin = block;
+    }
+    if (fragmented > fragmentationMax) {
+      fragmentationMax = fragmented;
+    }
+    samples++;
+    free = freeBytes;
+    maxBlock = block;
+    fragmentation = fragmented;
+  }
+};
+
+extern HeapStats heapStats;
+
+#if HEAP_SITE_TRACKING
+
+struct HeapSite {
+  const char* name;
+  uint32_t calls;
+  int32_t  retained;                    //bytes still allocated when the block was left, summed
+  int32_t  retainedMax;                 //most left allocated by one call
+  uint32_t blockShrinks;                //calls after which the largest free block was smaller
+  uint32_t freeMin;                     //lowest free heap seen when leaving the block
+};
+
+extern HeapSite heapSites[HEAP_SITE_MAX];
+extern uint8_t heapSiteCount;
+
+//Accounts the rest of the enclosing block to a site, sites are matched by name
+class HeapSiteScope {
+  public:
+    explicit HeapSiteScope(const char* name) : _site(find(name)), _free(ESP.getFreeHeap()), _block(ESP.getMaxFreeBlockSize()) { }
+    ~HeapSiteScope() {
+      if (_site == NULL) {
+        return;
+      }
+      uint32_t freeAfter = ESP.getFreeHeap();
+      int32_t retained = (int32_t)_free - (int32_t)freeAfter;
+      _site->calls++;
+      _site->retained += retained;
+      if (retained > _site->retainedMax) {
+        _site->retainedMax = retained;
+      }
+      if (ESP.getMaxFreeBlockSize() < _block) {
+        _site->blockShrinks++;
+      }
+      if (_site->freeMin == 0 || freeAfter < _site->freeMin) {
+        _site->freeMin = freeAfter;
+      }
+    }
+  private:
+    HeapSite* _site;
+    uint32_t _free;
+    uint32_t _block;
+
+    static HeapSite* find(const char* name) {
+      for (uint8_t i = 0; i < heapSiteCount; i++) {
+        if (heapSites[i].name == name || strcmp(heapSites[i].name, name) == 0) {
+          return &heapSites[i];
+        }
+      }
+      if (heapSiteCount == HEAP_SITE_MAX) {
+        return NULL;
+      }
+      heapSites[heapSiteCount].name = name;
+      return &heapSites[heapSiteCount++];
+    }
+};
+
+#define HEAP_CONCAT_(a, b) a##b
+#define HEAP_CONCAT(a, b)  HEAP_CONCAT_(a, b)
+#define HEAP_SITE(name) HeapSiteScope HEAP_CONCAT(heapSite, __LINE__)(name)
+
+#else
+
+#define HEAP_SITE(name)
+
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+//Heap sampling and reporting (see heapmonitor.h): /api/heap, /metrics and <mqtt_topic>_heap
+
+#if HEAP_SITE_TRACKING
+HeapSite heapSites[HEAP_SITE_MAX];
+uint8_t heapSiteCount = 0;
+#endif
+
+void heapSample() {
+  heapStats.sample(ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(), ESP.getHeapFragmentation());
+}
+
+//json of the current heap, the low-water marks since boot and, in a HEAP_SITE_TRACKING build, the sites
+void handleHeap() {
+  heapSample();
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+
+  metricsLine(PSTR("{\"free\":%u,\"free_min\":%u,\"block\":%u,\"block_min\":%u,\"frag\":%u,\"frag_max\":%u,\"samples\":%u"),
+              heapStats.free, heapStats.freeMin, heapStats.maxBlock, heapStats.maxBlockMin,
+              heapStats.fragmentation, heapStats.fragmentationMax, heapStats.samples);
+#if HEAP_SITE_TRACKING
+  metricsLine(PSTR(",\"sites\":["));
+  for (uint8_t i = 0; i < heapSiteCount; i++) {
+    const HeapSite& site = heapSites[i];
+    metricsLine(PSTR("%s{\"name\":\"%s\",\"calls\":%u,\"retained\":%d,\"retained_max\":%d,\"block_shrinks\":%u,\"free_min\":%u}"),
+                i == 0 ? "" : ",", site.name, site.calls, site.retained, site.retainedMax, site.blockShrinks, site.freeMin);
+  }
+  metricsLine(PSTR("]"));
+#endif
+  metricsLine(PSTR("}"));
+  server.sendContent("");
+}
+
+//Publish the heap health on <mqtt_topic>_heap:
+//{"free", "free_min", "block", "block_min", "frag", "frag_max"}
+void sendMqttHeap(){
+  char payload[128];
+  snprintf(payload, sizeof(payload), "{\"free\":%u,\"free_min\":%u,\"block\":%u,\"block_min\":%u,\"frag\":%u,\"frag_max\":%u}",
+           heapStats.free, heapStats.freeMin, heapStats.maxBlock, heapStats.maxBlockMin,
+           heapStats.fragmentation, heapStats.fragmentationMax);
+
+  char topic[sizeof(mqtt_topic) + 5];
+  strcpy(topic, mqtt_topic);
+  strcat(topic, "_heap");
+  metrics.telemetry(client.publish(topic, payload, true));
+
+  LOG_DEBUG("sending heap statistics with topic %s", topic);
+}
@@ -0,0 +1,150 @@
+/***************************************************************************
+ Main loop latency probes of the Salt sentry.
+
+ Every loop() iteration goes into a log2 histogram, and the sections that can
+ block (web server, mqtt, ranging, the publishers) are timed separately, so a
+ watchdog reset or an unresponsive page can be traced to the path that held
+ the loop. Times are taken with the CPU cycle counter, a probe is two reads
+ of a special register and a few adds. The counter wraps after 53 s at
+ 80 MHz (26 s at 160 MHz), far longer than any section is allowed to take.
+
+ The probes compile out when LATENCY_PROBES is 0, the report is then empty.
+ ***************************************************************************/
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef LATENCY_PROBES
+#define LATENCY_PROBES 1
+#endif
+
+//a section that runs at least this long (ms) is counted as blocking the loop
+#define LATENCY_BLOCK_MS 100
+
+//loop() histogram bucket n counts iterations of 2^n up to 2^(n+1) cycles
+#define LATENCY_LOOP_BUCKETS 32
+
+enum LatencySection {
+  SECTION_HANDLE_CLIENT,        //server.handleClient
+  SECTION_MQTT_LOOP,            //client.loop
+  SECTION_MQTT_RECONNECT,
+  SECTION_RANGING,              //lox.rangingTest
+  SECTION_SEND_MQTT,
+  SECTION_SEND_MQTT_BINARY,
+  SECTION_SEND_MQTT_WIFI,
+  SECTION_SEND_DOMOTICZ,
+  SECTION_SEND_OPENHAB,
+  SECTION_OTA_CHUNK,            //one range of a firmware download
+  SECTION_COUNT
+};
+
+static const char* const latencySectionNames[SECTION_COUNT] = {
+  "handle_client", "mqtt_loop", "mqtt_reconnect", "ranging",
+  "send_mqtt", "send_mqtt_binary", "send_mqtt_wifi", "send_domoticz", "send_openhab",
+  "ota_chunk"
+};
+
+struct SectionLatency {
+  uint32_t count;
+  uint64_t cycles;              //total
+  uint32_t maxCycles;
+  uint32_t maxAtMs;             //millis() of the longest run
+  uint32_t blocks;              //runs of LATENCY_BLOCK_MS or more
+};
+
+struct LatencyProfile {
+  uint32_t loopBuckets[LATENCY_LOOP_BUCKETS];
+  uint32_t loops;
+  uint32_t loopMaxCycles;
+  SectionLatency sections[SECTION_COUNT];
+  uint32_t sinceMs;             //millis() of the last reset
+  uint32_t blockCycles = LATENCY_BLOCK_MS * 80000UL;    //set for the real CPU clock by begin()
+
+  void begin(uint8_t cpuMHz) {
+    blockCycles = LATENCY_BLOCK_MS * 1000UL * cpuMHz;
+  }
+
+  void reset() {
+    memset(loopBuckets, 0, sizeof(loopBuckets));
+    loops = 0;
+    loopMaxCycles = 0;
+    memset(sections, 0, sizeof(sections));
+    sinceMs = millis();
+  }
+
+  void loop(uint32_t cycles) {
+    loops++;
+    loopBuckets[31 - __builtin_clz(cycles | 1)]++;
+    if (cycles > loopMaxCycles) {
+      loopMaxCycles = cycles;
+    }
+  }
+
+  void section(LatencySection id, uint32_t cycles) {
+    SectionLatency& s = sections[id];
+    s.count++;
+    s.cycles += cycles;
+    if (cycles > s.maxCycles) {
+      s.maxCycles = cycles;
+      s.maxAtMs = millis();
+    }
+    if (cycles >= blockCycles) {
+      s.blocks++;
+    }
+  }
+
+  //section ids ordered from the longest single run down, the worst offenders first
+  void ranking(uint8_t* order) const {
+    for (int i = 0; i < SECTION_COUNT; i++) {
+      int j = i;
+      while (j > 0 && sections[order[j - 1]].maxCycles < sections[i].maxCycles) {
+        order[j] = order[j - 1];
+        j--;
+      }
+      order[j] = i;
+    }
+  }
+};
+
+extern LatencyProfile latency;
+
+#if LATENCY_PROBES
+
+//Times the rest of the enclosing block
+class LatencyProbe {
+  public:
+    explicit LatencyProbe(LatencySection section) : _section(section), _start(ESP.getCycleCount()) { }
+    ~LatencyProbe() {
+      latency.section(_section, ESP.getCycleCount() - _start);
+    }
+  private:
+    LatencySection _section;
+    uint32_t _start;
+};
+
+class LoopProbe {
+  public:
+    LoopProbe() : _start(ESP.getCycleCount()) { }
+    ~LoopProbe() {
+      latency.loop(ESP.getCycleCount() - _start);
+    }
+  private:
+    uint32_t _start;
+};
+
+#define LATENCY_CONCAT_(a, b) a##b
+#define LATENCY_CONCAT(a, b)  LATENCY_CONCAT_(a, b)
+#define PROBE_SECTION(section) LatencyProbe LATENCY_CONCAT(latencyProbe, __LINE__)(section)
+#define PROBE_LOOP()           LoopProbe LATENCY_CONCAT(loopProbe, __LINE__)
+
+#else
+
+#define PROBE_SECTION(section)
+#define PROBE_LOOP()
+
+#endif
+
+#endif
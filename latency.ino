@@ -0,0 +1,81 @@
+//Loop latency report (see latency.h): /api/latency, reset with DELETE /api/latency, and <mqtt_topic>_latency
+
+void setupLatency() {
+  latency.begin(ESP.getCpuFreqMHz());
+  latency.reset();
+}
+
+//64 bit, the section totals pass 2^32 us after 71 minutes
+uint64_t latencyUs(uint64_t cycles) {
+  return cycles / ESP.getCpuFreqMHz();
+}
+
+//json report streamed in chunks, the sections ordered from the worst offender down. Times in microseconds,
+//max_age is how long ago (s) the longest run was. Every chunk stays below the 128 bytes of metricsLine
+//with all numbers at their maximum
+void handleLatency() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+
+  metricsLine(PSTR("{\"enabled\":%s,\"since\":%u,\"block_ms\":%u,"), LATENCY_PROBES ? "true" : "false",
+              (millis() - latency.sinceMs) / 1000, LATENCY_BLOCK_MS);
+  metricsLine(PSTR("\"loop\":{\"count\":%u,\"max_us\":%llu,\"histogram\":["), latency.loops, latencyUs(latency.loopMaxCycles));
+  bool first = true;
+  for (int i = 0; i < LATENCY_LOOP_BUCKETS; i++) {
+    if (latency.loopBuckets[i] != 0) {
+      metricsLine(PSTR("%s{\"le_us\":%llu,\"count\":%u}"), first ? "" : ",", latencyUs(2ULL << i), latency.loopBuckets[i]);
+      first = false;
+    }
+  }
+  metricsLine(PSTR("]},\"sections\":["));
+
+  uint8_t order[SECTION_COUNT];
+  latency.ranking(order);
+  for (int i = 0; i < SECTION_COUNT; i++) {
+    const SectionLatency& section = latency.sections[order[i]];
+    metricsLine(PSTR("%s{\"name\":\"%s\",\"count\":%u,\"total_us\":%llu,"),
+                i == 0 ? "" : ",", latencySectionNames[order[i]], section.count, latencyUs(section.cycles));
+    metricsLine(PSTR("\"max_us\":%llu,\"max_age\":%u,\"blocks\":%u}"), latencyUs(section.maxCycles),
+                section.count != 0 ? (millis() - section.maxAtMs) / 1000 : 0, section.blocks);
+  }
+  metricsLine(PSTR("]}"));
+  server.sendContent("");
+}
+
+void handleLatencyReset() {
+  latency.reset();
+  server.send(200, "application/json", "{\"reset\":true}");
+}
+
+//Publish the loop statistics and the three worst sections on <mqtt_topic>_latency, times in microseconds:
+//{"loops", "loop_max_us", "top": [[section, max_us, blocks], ...]}
+void sendMqttLatency(){
+  if (!LATENCY_PROBES) {
+    return;
+  }
+  uint8_t order[SECTION_COUNT];
+  latency.ranking(order);
+
+  char payload[192];
+  size_t used = snprintf(payload, sizeof(payload), "{\"loops\":%u,\"loop_max_us\":%llu,\"top\":[",
+                         latency.loops, latencyUs(latency.loopMaxCycles));
+  for (int i = 0; i < 3 && used < sizeof(payload); i++) {
+    const SectionLatency& section = latency.sections[order[i]];
+    used += snprintf(payload + used, sizeof(payload) - used, "%s[\"%s\",%llu,%u]", i == 0 ? "" : ",",
+                     latencySectionNames[order[i]], latencyUs(section.maxCycles), section.blocks);
+  }
+  if (used < sizeof(payload)) {
+    used += snprintf(payload + used, sizeof(payload) - used, "]}");
+  }
+  if (used >= sizeof(payload)) {
+    LOG_ERROR("latency payload does not fit, not sending");
+    return;
+  }
+
+  char topic[sizeof(mqtt_topic) + 8];
+  strcpy(topic, mqtt_topic);
+  strcat(topic, "_latency");
+  metrics.telemetry(client.publish(topic, payload, true));
+
+  LOG_DEBUG("sending loop latency with topic %s", topic);
+}
@@ -0,0 +1,34 @@
+/***************************************************************************
+ Salt level calculation of the Salt sentry.
+
+ Plain C++ without Arduino types, so the calculation can be compiled and
+ timed on a development machine like config.h and cbor.h.
+ ***************************************************************************/
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <math.h>
+
+//Fill level in percent, 1 decimal, from the distance between the sensor and the salt.
+//fullCm is the distance at which the salt counts as full, emptyCm where it counts as empty
+inline float calculatePercentage(float distanceCm, float fullCm, float emptyCm) {
+  float percentage;
+  float correctedRange = distanceCm - fullCm;
+
+  if (correctedRange < 0) {
+    percentage = 100;
+  } else {
+    percentage = correctedRange / ((emptyCm - fullCm) / 100);
+    if (percentage > 100) {
+      percentage = 0;
+    } else {
+      percentage = 100 - percentage;
+    }
+  }
+
+  // 1 decimal
+  percentage = percentage * 10;
+  return roundf(percentage) / 10;
+}
+
+#endif
@@ -0,0 +1,116 @@
+/***************************************************************************
+ Leveled logger of the Salt sentry.
+
+ Messages below LOG_LEVEL are removed by the preprocessor, their format
+ strings never reach flash. The others are checked against the runtime level
+ before the arguments are even evaluated, then formatted from PROGMEM into a
+ ring buffer. The buffer is drained to Serial only as far as the UART FIFO
+ has room, so logging never waits for the 115200 baud line. What was logged
+ last stays in the buffer and is served on /api/log.
+
+ The ring is single producer / single consumer: the writer only moves head,
+ the serial drain only moves sent, both are free running byte counts.
+ ***************************************************************************/
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+//messages above this level are not compiled in, build with -DLOG_LEVEL=LOG_LEVEL_DEBUG to get them
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_BUFFER_SIZE 2048    //power of two
+#define LOG_LINE_SIZE   160     //longer messages are cut off
+
+static const char logLevelLetters[] = "-EWID";
+
+struct LogBuffer {
+  char data[LOG_BUFFER_SIZE];
+  volatile uint32_t head;       //bytes written since boot
+  volatile uint32_t sent;       //bytes drained to serial since boot
+  uint32_t dropped;             //messages that did not fit while serial was behind
+
+  //append a whole message, or nothing when serial has not drained enough of the buffer
+  bool write(const char* text, size_t length) {
+    if (length > LOG_BUFFER_SIZE - (head - sent)) {
+      dropped++;
+      return false;
+    }
+    size_t start = head & (LOG_BUFFER_SIZE - 1);
+    size_t first = length < LOG_BUFFER_SIZE - start ? length : LOG_BUFFER_SIZE - start;
+    memcpy(data + start, text, first);
+    memcpy(data, text + first, length - first);
+    asm volatile ("" ::: "memory");     //the text is in place before head moves on
+    head += length;
+    return true;
+  }
+
+  //the next contiguous piece that has not been sent to serial yet, returns its length
+  size_t pending(const char** chunk) const {
+    uint32_t from = sent;
+    size_t start = from & (LOG_BUFFER_SIZE - 1);
+    size_t length = head - from;
+    *chunk = data + start;
+    return length < LOG_BUFFER_SIZE - start ? length : LOG_BUFFER_SIZE - start;
+  }
+
+  void consume(size_t length) {
+    sent += length;
+  }
+
+  //start of the oldest whole line still in the buffer
+  uint32_t oldest() const {
+    if (head <= LOG_BUFFER_SIZE) {
+      return 0;
+    }
+    uint32_t from = head - LOG_BUFFER_SIZE;
+    while (from != head && data[from++ & (LOG_BUFFER_SIZE - 1)] != '\n') {
+    }
+    return from;
+  }
+};
+
+extern LogBuffer logBuffer;
+extern uint8_t logLevel;        //runtime level, at most LOG_LEVEL
+
+#define LOG_AT(level, format, ...) do { \
+    if ((level) <= logLevel) { \
+      logWrite(level, PSTR(format), ##__VA_ARGS__); \
+    } \
+  } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) LOG_AT(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(format, ...) LOG_AT(LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) LOG_AT(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) LOG_AT(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) do { } while (0)
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+//Log output (see logger.h): formatting into the ring buffer, draining it to serial and /api/log
+
+//Format one message into the buffer, "[seconds.ms] L message", and send what fits to serial right away
+void logWrite(uint8_t level, PGM_P format, ...) {
+  char line[LOG_LINE_SIZE];
+  unsigned long now = millis();
+  int length = snprintf_P(line, sizeof(line), PSTR("[%5lu.%03lu] %c "), now / 1000, now % 1000, logLevelLetters[level]);
+
+  va_list args;
+  va_start(args, format);
+  int message = vsnprintf_P(line + length, sizeof(line) - length - 1, format, args);
+  va_end(args);
+  if (message > 0) {
+    length += min(message, (int)sizeof(line) - length - 2);
+  }
+  line[length++] = '\n';
+
+  logBuffer.write(line, length);
+  logDrain();
+}
+
+//Write pending output as far as the UART FIFO has room, never waits
+void logDrain() {
+  const char* chunk;
+  size_t length;
+  while ((length = logBuffer.pending(&chunk)) > 0) {
+    size_t room = Serial.availableForWrite();
+    if (room == 0) {
+      return;
+    }
+    logBuffer.consume(Serial.write((const uint8_t*)chunk, min(length, room)));
+  }
+}
+
+//Write everything pending, waiting for serial. Only for a restart, where the output would be lost otherwise
+void logFlush() {
+  const char* chunk;
+  size_t length;
+  while ((length = logBuffer.pending(&chunk)) > 0) {
+    logBuffer.consume(Serial.write((const uint8_t*)chunk, length));
+  }
+  Serial.flush();
+}
+
+//The recent log as plain text, oldest line first
+void handleLog() {
+  uint32_t from = logBuffer.oldest();
+  uint32_t to = logBuffer.head;
+
+  server.sendHeader("X-Log-Dropped", String(logBuffer.dropped));
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain", "");
+  while (from != to) {
+    size_t start = from & (LOG_BUFFER_SIZE - 1);
+    size_t length = min((size_t)(to - from), (size_t)LOG_BUFFER_SIZE - start);
+    server.sendContent(logBuffer.data + start, length);
+    from += length;
+  }
+  server.sendContent("");
+}
+
+//Change the runtime level, levels that were not compiled in (LOG_LEVEL) stay off
+void handleLogLevel() {
+  int level = server.arg("level").toInt();
+  if (!server.hasArg("level") || level < LOG_LEVEL_NONE || level > LOG_LEVEL_DEBUG) {
+    server.send(400, "application/json", "{\"error\":\"level must be 0 (none) to 4 (debug)\"}");
+    return;
+  }
+  logLevel = min(level, LOG_LEVEL);
+  LOG_INFO("log level set to %u", logLevel);
+  server.send(200, "application/json", "{\"level\":" + String(logLevel) + "}");
+}
@@ -1,35 +1,28 @@
 void sendOpenHabMessage(float percentage, float distanceCm){
-  Serial.println(percentage);
-  Serial.println(distanceCm);
-  
-  char result[8];
-  Serial.print("sending ");
-  Serial.print(percentage);
-  Serial.print(" as percentage to openHAB on url: ");
-  Serial.println("http://" + String(mqtt_server) + ":" + String(mqtt_port) +"/rest/items/" + String(oh_itemid)); 
+  PROBE_SECTION(SECTION_SEND_OPENHAB);
+  HEAP_SITE("send_openhab");
+  LOG_DEBUG("sending %.2f as percentage to openHAB on url: http://%s:%s/rest/items/%s", percentage, mqtt_server, mqtt_port, oh_itemid);
   http.begin("http://" + String(mqtt_server) + ":" + String(mqtt_port) +"/rest/items/" + String(oh_itemid)); 
   http.addHeader("Content-Type", "text/plain");
-  http.POST(String(percentage));
+  int httpCode = http.POST(String(percentage));
+  metrics.publish(SINK_OPENHAB, httpCode >= 200 && httpCode < 300);
   http.end();
   
 //  dtostrf(distanceCm, 3, 1, result); 
-  Serial.print("sending ");
-  Serial.print(distanceCm);
-  Serial.print(" as distance to openHAB on url: ");
-  Serial.println("http://" + String(mqtt_server) + ":" + String(mqtt_port) +"/rest/items/" + String(oh_itemid) + "_cm"); 
+  LOG_DEBUG("sending %.2f as distance to openHAB on url: http://%s:%s/rest/items/%s_cm", distanceCm, mqtt_server, mqtt_port, oh_itemid);
   http.begin("http://" + String(mqtt_server) + ":" + String(mqtt_port) +"/rest/items/" + String(oh_itemid) + "_cm");
   http.addHeader("Content-Type", "text/plain"); 
-  http.POST(String(distanceCm));
+  httpCode = http.POST(String(distanceCm));
+  metrics.publish(SINK_OPENHAB, httpCode >= 200 && httpCode < 300);
   http.end();
 }
 
 void sendDomoticzMessage(float percentage, float distanceCm){
+  PROBE_SECTION(SECTION_SEND_DOMOTICZ);
+  HEAP_SITE("send_domoticz");
   char result[8];
   if (espClient.connect(mqtt_server,atoi(mqtt_port))){
-      Serial.print("sending ");
-      Serial.print(percentage);
-      Serial.print(" as percentage to domotics on IDX ");
-      Serial.println(dz_idx);
+      LOG_DEBUG("sending %.2f as percentage to domotics on IDX %s", percentage, dz_idx);
       espClient.print("GET /json.htm?type=command&param=udevice&idx=");
       espClient.print(String(dz_idx));
       espClient.print("&nvalue=0");
@@ -52,15 +45,15 @@ void sendDomoticzMessage(float percentage, float distanceCm){
       espClient.println("Connection: close");
       espClient.println();
       espClient.stop();
-  } 
+      metrics.publish(SINK_DOMOTICZ, true);
+  } else {
+     metrics.publish(SINK_DOMOTICZ, false);
+  }
   //reconnect required
   if (espClient.connect(mqtt_server,atoi(mqtt_port))){
 
 //      dtostrf(distanceCm, 3, 0, result);   
-      Serial.print("sending ");
-      Serial.print(distanceCm);
-      Serial.print(" as distance to domotics on IDX ");
-      Serial.println(atoi(dz_idx) + 1);
+      LOG_DEBUG("sending %.2f as distance to domotics on IDX %d", distanceCm, atoi(dz_idx) + 1);
       espClient.print("GET /json.htm?type=command&param=udevice&idx=");
       espClient.print(String(atoi(dz_idx) + 1));
       espClient.print("&nvalue=0");
@@ -84,37 +77,77 @@ void sendDomoticzMessage(float percentage, float distanceCm){
       espClient.println("Connection: close");
       espClient.println();
       espClient.stop();
-      
+      metrics.publish(SINK_DOMOTICZ, true);
       
    } else {
-     Serial.println("connect failed");
+     metrics.publish(SINK_DOMOTICZ, false);
+     LOG_WARN("domoticz connect failed");
    }
 }
 
 void sendMqttMessage(float percentage, float distanceCm){
+  PROBE_SECTION(SECTION_SEND_MQTT);
+  HEAP_SITE("send_mqtt");
   char tempString[8];
   dtostrf(percentage, 4, 1, tempString);
-  client.publish(mqtt_topic, tempString , true);
+  metrics.publish(SINK_MQTT, client.publish(mqtt_topic, tempString , true));
   strcpy(mqtt_distance_topic, mqtt_topic);
   strcat(mqtt_distance_topic, "_distance");
   dtostrf(distanceCm, 4, 1, tempString);    
-  client.publish(mqtt_distance_topic, tempString , true);
+  metrics.publish(SINK_MQTT, client.publish(mqtt_distance_topic, tempString , true));
   
-  Serial.print("sending ");
-  Serial.print(percentage);
-  Serial.print("  to ");
-  Serial.print(mqtt_server);
-  Serial.print(" on port ");
-  Serial.print(mqtt_port);
-  Serial.print(" with topic ");
-  Serial.println(mqtt_topic);
+  LOG_DEBUG("sending %.2f to %s on port %s with topic %s", percentage, mqtt_server, mqtt_port, mqtt_topic);
+  LOG_DEBUG("sending %.2f to %s on port %s with topic %s", distanceCm, mqtt_server, mqtt_port, mqtt_distance_topic);
+}
+
+//Publish one self describing CBOR record per measurement (see encodeTelemetry in cbor.h)
+void sendMqttBinaryMessage(float percentage, float distanceCm, uint8_t rangeStatus){
+  PROBE_SECTION(SECTION_SEND_MQTT_BINARY);
+  uint8_t payload[48];
+  CborWriter cbor(payload, sizeof(payload));
+  encodeTelemetry(cbor, percentage, distanceCm, rangeStatus, millis() / 1000);
+
+  if (!cbor.ok()) {
+    LOG_ERROR("binary payload does not fit, not sending");
+    return;
+  }
+
+  char topic[sizeof(mqtt_topic) + 5];
+  strcpy(topic, mqtt_topic);
+  strcat(topic, "_cbor");
+  metrics.publish(SINK_MQTT, client.publish(topic, payload, cbor.length(), true));
+
+  LOG_DEBUG("sending %u byte binary record with topic %s", cbor.length(), topic);
+}
+
+//Publish the WiFi link statistics on <mqtt_topic>_wifi, times in ms:
+//{"rssi", "rssi_min", "rssi_max", "reconnects", "disconnects", "last_reason", "assoc_ms", "dhcp_ms", "first_publish_ms"}
+void sendMqttWifiStats(){
+  PROBE_SECTION(SECTION_SEND_MQTT_WIFI);
+  uint32_t disconnects = 0;
+  for (int i = 0; i < DISCONNECT_REASON_SLOTS; i++) {
+    disconnects += metrics.wifiDisconnects[i];
+  }
+
+  StaticJsonBuffer<JSON_OBJECT_SIZE(9)> jsonBuffer;
+  JsonObject& json = jsonBuffer.createObject();
+  json["rssi"] = WiFi.RSSI();
+  json["rssi_min"] = (int)metrics.rssiMin;
+  json["rssi_max"] = (int)metrics.rssiMax;
+  json["reconnects"] = metrics.wifiReconnects;
+  json["disconnects"] = disconnects;
+  json["last_reason"] = (int)metrics.wifiLastDisconnectReason;
+  json["assoc_ms"] = metrics.wifiAssociate.lastMs;
+  json["dhcp_ms"] = metrics.wifiDhcp.lastMs;
+  json["first_publish_ms"] = metrics.firstPublishMs;
+
+  char payload[192];
+  json.printTo(payload, sizeof(payload));
+
+  char topic[sizeof(mqtt_topic) + 5];
+  strcpy(topic, mqtt_topic);
+  strcat(topic, "_wifi");
+  metrics.telemetry(client.publish(topic, payload, true));
 
-  Serial.print("sending ");
-  Serial.print(distanceCm);
-  Serial.print("  to ");
-  Serial.print(mqtt_server);
-  Serial.print(" on port ");
-  Serial.print(mqtt_port);
-  Serial.print(" with topic ");
-  Serial.println(mqtt_distance_topic);
+  LOG_DEBUG("sending wifi statistics with topic %s", topic);
 }
@@ -0,0 +1,165 @@
+/***************************************************************************
+ Runtime counters for the /metrics (Prometheus) endpoint.
+
+ The counters are plain integers updated on the hot paths, the endpoint only
+ formats them when it is scraped.
+ ***************************************************************************/
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+//upper bounds (ms) of the measurement duration histogram buckets, +Inf is implicit
+#define MEASUREMENT_BUCKETS 6
+static const uint16_t measurementBucketsMs[MEASUREMENT_BUCKETS] = { 25, 50, 100, 200, 500, 1000 };
+
+//VL53L0X RangeStatus values 0..5, anything else is counted in the last slot
+#define RANGE_STATUS_COUNT 7
+
+enum PublishSink {
+  SINK_MQTT,
+  SINK_DOMOTICZ,
+  SINK_OPENHAB,
+  SINK_COUNT
+};
+
+static const char* const publishSinkNames[SINK_COUNT] = { "mqtt", "domoticz", "openhab" };
+
+//upper bounds (ms) of the WiFi association and DHCP time histogram buckets, +Inf is implicit
+#define WIFI_TIME_BUCKETS 7
+static const uint16_t wifiTimeBucketsMs[WIFI_TIME_BUCKETS] = { 100, 250, 500, 1000, 2500, 5000, 10000 };
+
+//upper bounds (dBm) of the RSSI histogram buckets, +Inf is implicit
+#define RSSI_BUCKETS 5
+static const int8_t rssiBucketsDbm[RSSI_BUCKETS] = { -90, -80, -70, -60, -50 };
+
+//SDK disconnect reasons 1..24 are counted in slots 1..24, 200..206 in slots 25..31, anything else in slot 0
+#define DISCONNECT_REASON_SLOTS 32
+
+inline uint8_t disconnectReasonSlot(uint8_t reason) {
+  if (reason >= 1 && reason <= 24) {
+    return reason;
+  }
+  if (reason >= 200 && reason <= 206) {
+    return reason - 200 + 25;
+  }
+  return 0;
+}
+
+inline uint8_t disconnectSlotReason(uint8_t slot) {
+  return slot <= 24 ? slot : slot - 25 + 200;
+}
+
+struct TimeHistogram {
+  uint32_t buckets[WIFI_TIME_BUCKETS + 1];
+  uint32_t count;
+  uint32_t msSum;
+  uint32_t lastMs;
+
+  void add(uint32_t ms) {
+    count++;
+    msSum += ms;
+    lastMs = ms;
+    uint8_t bucket = 0;
+    while (bucket < WIFI_TIME_BUCKETS && ms > wifiTimeBucketsMs[bucket]) {
+      bucket++;
+    }
+    buckets[bucket]++;
+  }
+};
+
+struct Metrics {
+  uint32_t measurements;
+  uint32_t measurementBuckets[MEASUREMENT_BUCKETS + 1];
+  uint32_t measurementMsSum;
+  uint32_t rangeStatus[RANGE_STATUS_COUNT];
+
+  uint32_t publishOk[SINK_COUNT];
+  uint32_t publishFailed[SINK_COUNT];
+  uint32_t telemetryOk;               //mqtt publishes of the device statistics (wifi, heap, latency, boot)
+  uint32_t telemetryFailed;
+  uint32_t mqttReconnects;
+
+  uint32_t wifiReconnects;
+  TimeHistogram wifiAssociate;        //start of a (re)connect until associated with the access point
+  TimeHistogram wifiDhcp;             //associated until the station has an ip address
+  uint32_t wifiDisconnects[DISCONNECT_REASON_SLOTS];
+  uint8_t  wifiLastDisconnectReason;
+  uint32_t rssiBuckets[RSSI_BUCKETS + 1];
+  uint32_t rssiSamples;
+  int32_t  rssiSum;
+  int8_t   rssiMin;
+  int8_t   rssiMax;
+
+  uint32_t firstPublishMs;            //boot until the first successful publish, 0 before it
+
+  uint32_t configWrites;
+  uint32_t configWritesSkipped;       //saves where the stored record was already up to date
+
+  uint32_t loopIterations;
+  uint64_t loopUsSum;
+  uint32_t loopUsMax;
+
+  void measurement(uint32_t ms, uint8_t status) {
+    measurements++;
+    measurementMsSum += ms;
+    uint8_t bucket = 0;
+    while (bucket < MEASUREMENT_BUCKETS && ms > measurementBucketsMs[bucket]) {
+      bucket++;
+    }
+    measurementBuckets[bucket]++;
+    rangeStatus[status < RANGE_STATUS_COUNT - 1 ? status : RANGE_STATUS_COUNT - 1]++;
+  }
+
+  void publish(PublishSink sink, bool ok) {
+    if (ok) {
+      if (firstPublishMs == 0) {
+        firstPublishMs = millis();
+      }
+      publishOk[sink]++;
+    } else {
+      publishFailed[sink]++;
+    }
+  }
+
+  //device statistics are no measurements, they count neither as a publish nor as the first one
+  void telemetry(bool ok) {
+    if (ok) {
+      telemetryOk++;
+    } else {
+      telemetryFailed++;
+    }
+  }
+
+  void rssi(int8_t dbm) {
+    if (rssiSamples == 0 || dbm < rssiMin) {
+      rssiMin = dbm;
+    }
+    if (rssiSamples == 0 || dbm > rssiMax) {
+      rssiMax = dbm;
+    }
+    rssiSamples++;
+    rssiSum += dbm;
+    uint8_t bucket = 0;
+    while (bucket < RSSI_BUCKETS && dbm > rssiBucketsDbm[bucket]) {
+      bucket++;
+    }
+    rssiBuckets[bucket]++;
+  }
+
+  void disconnect(uint8_t reason) {
+    wifiDisconnects[disconnectReasonSlot(reason)]++;
+    wifiLastDisconnectReason = reason;
+  }
+
+  void loopTime(uint32_t us) {
+    loopIterations++;
+    loopUsSum += us;
+    if (us > loopUsMax) {
+      loopUsMax = us;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,217 @@
+//Prometheus text exposition of the runtime counters in metrics.h, and the WiFi telemetry that feeds them
+
+//RSSI is sampled into the histogram this often (ms)
+#define RSSI_SAMPLE_INTERVAL 10000
+
+unsigned long wifiConnectStart = 0;     //start of the current (re)connect
+unsigned long wifiAssociatedAt = 0;
+unsigned long lastRssiSample = 0;
+bool wifiLinkUp = false;
+bool wifiAssociated = false;            //associated in the current (re)connect, wifiAssociatedAt is valid
+bool wifiFirstConnect = true;
+
+//Register the WiFi event handlers, before the first connect so its timing is recorded too
+void setupWifiTelemetry() {
+  wifiConnectStart = millis();
+  wifiConnectedHandler = WiFi.onStationModeConnected([](const WiFiEventStationModeConnected& event) {
+    wifiAssociatedAt = millis();
+    wifiAssociated = true;
+    metrics.wifiAssociate.add(wifiAssociatedAt - wifiConnectStart);
+  });
+  wifiGotIpHandler = WiFi.onStationModeGotIP([](const WiFiEventStationModeGotIP& event) {
+    //an address change on a link that stays up (the fast reconnect lease handed back to DHCP) is no reconnect
+    if (wifiLinkUp) {
+      return;
+    }
+    if (wifiAssociated) {
+      metrics.wifiDhcp.add(millis() - wifiAssociatedAt);
+    }
+    wifiLinkUp = true;
+    wifiAssociated = false;
+    //count every later (re)connect
+    if (!wifiFirstConnect) {
+      metrics.wifiReconnects++;
+    }
+    wifiFirstConnect = false;
+  });
+  wifiDisconnectedHandler = WiFi.onStationModeDisconnected([](const WiFiEventStationModeDisconnected& event) {
+    metrics.disconnect(event.reason);
+    wifiAssociated = false;
+    //failed attempts while reconnecting are counted, but the reconnect is timed from the moment the link went down
+    if (wifiLinkUp) {
+      wifiLinkUp = false;
+      wifiConnectStart = millis();
+    }
+  });
+}
+
+void wifiTelemetryLoop() {
+  if (millis() - lastRssiSample >= RSSI_SAMPLE_INTERVAL) {
+    lastRssiSample = millis();
+    if (WiFi.status() == WL_CONNECTED) {
+      metrics.rssi(WiFi.RSSI());
+    }
+  }
+}
+
+//Prometheus histogram of one of the WiFi connect time histograms
+void metricsTimeHistogram(const char* name, const TimeHistogram& histogram) {
+  uint32_t cumulative = 0;
+  for (int i = 0; i < WIFI_TIME_BUCKETS; i++) {
+    cumulative += histogram.buckets[i];
+    metricsLine(PSTR("%s_bucket{le=\"%u.%03u\"} %u\n"), name, wifiTimeBucketsMs[i] / 1000, wifiTimeBucketsMs[i] % 1000, cumulative);
+  }
+  metricsLine(PSTR("%s_bucket{le=\"+Inf\"} %u\n"), name, histogram.count);
+  metricsLine(PSTR("%s_sum %u.%03u\n"), name, histogram.msSum / 1000, histogram.msSum % 1000);
+  metricsLine(PSTR("%s_count %u\n"), name, histogram.count);
+}
+
+//Format one line into a small stack buffer and send it as a chunk
+void metricsLine(PGM_P format, ...) {
+  char line[128];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf_P(line, sizeof(line), format, args);
+  va_end(args);
+  if (length >= (int)sizeof(line)) {
+    LOG_ERROR("metrics line of %d bytes cut off at %u", length, (unsigned)(sizeof(line) - 1));
+  }
+  if (length > 0) {
+    server.sendContent(line, min((size_t)length, sizeof(line) - 1));
+  }
+}
+
+void handleMetrics() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain; version=0.0.4", "");
+
+  metricsLine(PSTR("# HELP saltsentry_measurement_duration_seconds Time spent in a VL53L0X ranging measurement\n"));
+  metricsLine(PSTR("# TYPE saltsentry_measurement_duration_seconds histogram\n"));
+  uint32_t cumulative = 0;
+  for (int i = 0; i < MEASUREMENT_BUCKETS; i++) {
+    cumulative += metrics.measurementBuckets[i];
+    metricsLine(PSTR("saltsentry_measurement_duration_seconds_bucket{le=\"%u.%03u\"} %u\n"),
+                measurementBucketsMs[i] / 1000, measurementBucketsMs[i] % 1000, cumulative);
+  }
+  metricsLine(PSTR("saltsentry_measurement_duration_seconds_bucket{le=\"+Inf\"} %u\n"), metrics.measurements);
+  metricsLine(PSTR("saltsentry_measurement_duration_seconds_sum %u.%03u\n"), metrics.measurementMsSum / 1000, metrics.measurementMsSum % 1000);
+  metricsLine(PSTR("saltsentry_measurement_duration_seconds_count %u\n"), metrics.measurements);
+
+  metricsLine(PSTR("# HELP saltsentry_range_status_total Measurements by VL53L0X RangeStatus\n"));
+  metricsLine(PSTR("# TYPE saltsentry_range_status_total counter\n"));
+  for (int i = 0; i < RANGE_STATUS_COUNT - 1; i++) {
+    metricsLine(PSTR("saltsentry_range_status_total{status=\"%d\"} %u\n"), i, metrics.rangeStatus[i]);
+  }
+  metricsLine(PSTR("saltsentry_range_status_total{status=\"other\"} %u\n"), metrics.rangeStatus[RANGE_STATUS_COUNT - 1]);
+
+  metricsLine(PSTR("# HELP saltsentry_publish_total Measurement publishes by sink and result\n"));
+  metricsLine(PSTR("# TYPE saltsentry_publish_total counter\n"));
+  for (int i = 0; i < SINK_COUNT; i++) {
+    metricsLine(PSTR("saltsentry_publish_total{sink=\"%s\",result=\"success\"} %u\n"), publishSinkNames[i], metrics.publishOk[i]);
+    metricsLine(PSTR("saltsentry_publish_total{sink=\"%s\",result=\"failure\"} %u\n"), publishSinkNames[i], metrics.publishFailed[i]);
+  }
+
+  metricsLine(PSTR("# HELP saltsentry_telemetry_publish_total Mqtt publishes of the wifi, heap, latency and boot statistics by result\n"));
+  metricsLine(PSTR("# TYPE saltsentry_telemetry_publish_total counter\n"));
+  metricsLine(PSTR("saltsentry_telemetry_publish_total{result=\"success\"} %u\n"), metrics.telemetryOk);
+  metricsLine(PSTR("saltsentry_telemetry_publish_total{result=\"failure\"} %u\n"), metrics.telemetryFailed);
+
+  metricsLine(PSTR("# HELP saltsentry_mqtt_reconnects_total Successful connections to the mqtt server\n"));
+  metricsLine(PSTR("# TYPE saltsentry_mqtt_reconnects_total counter\n"));
+  metricsLine(PSTR("saltsentry_mqtt_reconnects_total %u\n"), metrics.mqttReconnects);
+
+  metricsLine(PSTR("# HELP saltsentry_heap_free_bytes Free heap\n"));
+  metricsLine(PSTR("# TYPE saltsentry_heap_free_bytes gauge\n"));
+  metricsLine(PSTR("saltsentry_heap_free_bytes %u\n"), ESP.getFreeHeap());
+  metricsLine(PSTR("# HELP saltsentry_heap_max_free_block_bytes Largest free heap block\n"));
+  metricsLine(PSTR("# TYPE saltsentry_heap_max_free_block_bytes gauge\n"));
+  metricsLine(PSTR("saltsentry_heap_max_free_block_bytes %u\n"), ESP.getMaxFreeBlockSize());
+  metricsLine(PSTR("# HELP saltsentry_heap_free_min_bytes Lowest sampled free heap since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_heap_free_min_bytes gauge\n"));
+  metricsLine(PSTR("saltsentry_heap_free_min_bytes %u\n"), heapStats.freeMin);
+  metricsLine(PSTR("# HELP saltsentry_heap_max_free_block_min_bytes Smallest sampled largest free block since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_heap_max_free_block_min_bytes gauge\n"));
+  metricsLine(PSTR("saltsentry_heap_max_free_block_min_bytes %u\n"), heapStats.maxBlockMin);
+  metricsLine(PSTR("# HELP saltsentry_heap_fragmentation_percent Heap fragmentation\n"));
+  metricsLine(PSTR("# TYPE saltsentry_heap_fragmentation_percent gauge\n"));
+  metricsLine(PSTR("saltsentry_heap_fragmentation_percent %u\n"), ESP.getHeapFragmentation());
+  metricsLine(PSTR("# HELP saltsentry_heap_fragmentation_max_percent Highest sampled heap fragmentation since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_heap_fragmentation_max_percent gauge\n"));
+  metricsLine(PSTR("saltsentry_heap_fragmentation_max_percent %u\n"), heapStats.fragmentationMax);
+
+  metricsLine(PSTR("# HELP saltsentry_loop_duration_seconds Time spent in one loop() iteration\n"));
+  metricsLine(PSTR("# TYPE saltsentry_loop_duration_seconds summary\n"));
+  metricsLine(PSTR("saltsentry_loop_duration_seconds_sum %u.%06u\n"), (uint32_t)(metrics.loopUsSum / 1000000), (uint32_t)(metrics.loopUsSum % 1000000));
+  metricsLine(PSTR("saltsentry_loop_duration_seconds_count %u\n"), metrics.loopIterations);
+  metricsLine(PSTR("# HELP saltsentry_loop_duration_max_seconds Longest loop() iteration since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_loop_duration_max_seconds gauge\n"));
+  metricsLine(PSTR("saltsentry_loop_duration_max_seconds %u.%06u\n"), metrics.loopUsMax / 1000000, metrics.loopUsMax % 1000000);
+
+  metricsLine(PSTR("# HELP saltsentry_wifi_rssi_dbm WiFi signal strength\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_rssi_dbm gauge\n"));
+  metricsLine(PSTR("saltsentry_wifi_rssi_dbm %d\n"), WiFi.RSSI());
+  metricsLine(PSTR("# HELP saltsentry_wifi_reconnects_total WiFi connections after the initial one\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_reconnects_total counter\n"));
+  metricsLine(PSTR("saltsentry_wifi_reconnects_total %u\n"), metrics.wifiReconnects);
+
+  metricsLine(PSTR("# HELP saltsentry_wifi_rssi_samples_dbm WiFi signal strength, sampled every 10 seconds\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_rssi_samples_dbm histogram\n"));
+  cumulative = 0;
+  for (int i = 0; i < RSSI_BUCKETS; i++) {
+    cumulative += metrics.rssiBuckets[i];
+    metricsLine(PSTR("saltsentry_wifi_rssi_samples_dbm_bucket{le=\"%d\"} %u\n"), rssiBucketsDbm[i], cumulative);
+  }
+  metricsLine(PSTR("saltsentry_wifi_rssi_samples_dbm_bucket{le=\"+Inf\"} %u\n"), metrics.rssiSamples);
+  metricsLine(PSTR("saltsentry_wifi_rssi_samples_dbm_sum %d\n"), metrics.rssiSum);
+  metricsLine(PSTR("saltsentry_wifi_rssi_samples_dbm_count %u\n"), metrics.rssiSamples);
+  metricsLine(PSTR("# HELP saltsentry_wifi_rssi_min_dbm Weakest sampled signal since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_rssi_min_dbm gauge\n"));
+  metricsLine(PSTR("saltsentry_wifi_rssi_min_dbm %d\n"), metrics.rssiMin);
+
+  metricsLine(PSTR("# HELP saltsentry_wifi_disconnects_total WiFi disconnects and failed connects by SDK reason code\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_disconnects_total counter\n"));
+  for (int i = 1; i < DISCONNECT_REASON_SLOTS; i++) {
+    if (metrics.wifiDisconnects[i] != 0) {
+      metricsLine(PSTR("saltsentry_wifi_disconnects_total{reason=\"%u\"} %u\n"), disconnectSlotReason(i), metrics.wifiDisconnects[i]);
+    }
+  }
+  metricsLine(PSTR("saltsentry_wifi_disconnects_total{reason=\"other\"} %u\n"), metrics.wifiDisconnects[0]);
+
+  metricsLine(PSTR("# HELP saltsentry_wifi_associate_seconds Time from the start of a (re)connect until associated\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_associate_seconds histogram\n"));
+  metricsTimeHistogram("saltsentry_wifi_associate_seconds", metrics.wifiAssociate);
+  metricsLine(PSTR("# HELP saltsentry_wifi_dhcp_seconds Time from association until the station has an ip address\n"));
+  metricsLine(PSTR("# TYPE saltsentry_wifi_dhcp_seconds histogram\n"));
+  metricsTimeHistogram("saltsentry_wifi_dhcp_seconds", metrics.wifiDhcp);
+
+  metricsLine(PSTR("# HELP saltsentry_first_publish_seconds Time from boot until the first successful publish\n"));
+  metricsLine(PSTR("# TYPE saltsentry_first_publish_seconds gauge\n"));
+  metricsLine(PSTR("saltsentry_first_publish_seconds %u.%03u\n"), metrics.firstPublishMs / 1000, metrics.firstPublishMs % 1000);
+
+  metricsLine(PSTR("# HELP saltsentry_config_writes_total Settings written to flash\n"));
+  metricsLine(PSTR("# TYPE saltsentry_config_writes_total counter\n"));
+  metricsLine(PSTR("saltsentry_config_writes_total %u\n"), metrics.configWrites);
+  metricsLine(PSTR("# HELP saltsentry_config_writes_skipped_total Settings saves that needed no flash write\n"));
+  metricsLine(PSTR("# TYPE saltsentry_config_writes_skipped_total counter\n"));
+  metricsLine(PSTR("saltsentry_config_writes_skipped_total %u\n"), metrics.configWritesSkipped);
+
+  metricsLine(PSTR("# HELP saltsentry_task_runs_total Runs of each scheduler task\n"));
+  metricsLine(PSTR("# TYPE saltsentry_task_runs_total counter\n"));
+  for (size_t i = 0; i < scheduler.taskCount(); i++) {
+    metricsLine(PSTR("saltsentry_task_runs_total{task=\"%s\"} %u\n"), scheduler.task(i).name, scheduler.task(i).runs);
+  }
+  metricsLine(PSTR("# HELP saltsentry_task_max_seconds Longest run of each scheduler task since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_task_max_seconds gauge\n"));
+  for (size_t i = 0; i < scheduler.taskCount(); i++) {
+    metricsLine(PSTR("saltsentry_task_max_seconds{task=\"%s\"} %u.%06u\n"), scheduler.task(i).name, scheduler.task(i).maxUs / 1000000, scheduler.task(i).maxUs % 1000000);
+  }
+  metricsLine(PSTR("# HELP saltsentry_scheduler_overruns_total Loop slices that ran out of time with tasks still due\n"));
+  metricsLine(PSTR("# TYPE saltsentry_scheduler_overruns_total counter\n"));
+  metricsLine(PSTR("saltsentry_scheduler_overruns_total %u\n"), scheduler.overruns);
+
+  metricsLine(PSTR("# HELP saltsentry_uptime_seconds Time since boot\n"));
+  metricsLine(PSTR("# TYPE saltsentry_uptime_seconds counter\n"));
+  metricsLine(PSTR("saltsentry_uptime_seconds %u\n"), (uint32_t)(millis() / 1000));
+
+  server.sendContent("");
+}
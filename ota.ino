@@ -0,0 +1,274 @@
+//Firmware updates over http. The manifest at ota_url names the newest firmware:
+//{"version": "0.2.0", "url": "http://host/firmware.bin.gz", "size": bytes, "md5": "hex digest of the image"}
+//A newer version is downloaded in range requests of OTA_CHUNK_SIZE. A task run reads what has arrived and
+//reschedules itself for the rest, so the other tasks keep running in between, and a dropped connection
+//resumes at the last byte written. gzip images are
+//stored as they are and inflated by the bootloader, the md5 is checked over the image as downloaded.
+//tools/ota_server.py is a local update server for testing
+
+#define OTA_CHECK_INTERVAL 21600000UL   //ms between manifest checks, 6 hours
+#define OTA_FIRST_CHECK    60000        //ms after boot
+#define OTA_CHUNK_SIZE     4096         //one flash sector per request
+#define OTA_CHUNK_INTERVAL 20           //ms between chunks
+#define OTA_CHUNK_TIMEOUT  5000         //ms a chunk may take
+#define OTA_READ_INTERVAL  10           //ms until the next look for more of a chunk
+#define OTA_MANIFEST_MAX_SIZE 512       //bytes, a larger manifest is rejected before it is read
+#define OTA_MAX_RETRIES    5
+#define OTA_RETRY_DELAY    10000        //ms
+
+enum OtaState {
+  OTA_IDLE,
+  OTA_DOWNLOADING,
+  OTA_DONE,                             //restarting into the new firmware
+  OTA_FAILED
+};
+
+static const char* const otaStateNames[] = { "idle", "downloading", "done", "failed" };
+
+OtaState otaState = OTA_IDLE;
+char otaVersion[16] = "";
+char otaImageUrl[128];
+char otaMd5[33];
+uint32_t otaSize = 0;
+uint32_t otaOffset = 0;                 //bytes written to flash, the next range starts here
+uint8_t otaRetries = 0;
+char otaError[48] = "";
+bool otaReceiving = false;              //a range request is open, its body is read as it arrives
+uint32_t otaChunkEnd = 0;               //end of the open range
+unsigned long otaChunkStart = 0;
+const char* otaCollectedHeaders[] = { "Content-Range" };
+
+WiFiClient otaClient;
+HTTPClient otaHttp;
+
+Task otaCheckTask   = { "ota_check",   otaCheck,         PRIORITY_LOW };
+Task otaChunkTask   = { "ota_chunk",   otaDownloadChunk, PRIORITY_LOW };
+Task otaRestartTask = { "ota_restart", otaRestart,       PRIORITY_HIGH };
+
+void setupOta() {
+  otaHttp.setTimeout(HTTP_CLIENT_TIMEOUT);
+  otaHttp.setReuse(true);
+  scheduler.every(otaCheckTask, OTA_CHECK_INTERVAL, OTA_FIRST_CHECK);
+  scheduler.track(otaChunkTask);
+  scheduler.track(otaRestartTask);
+}
+
+//Compare dotted version numbers, "0.1.10" is newer than "0.1.9". Returns <0, 0 or >0
+int compareVersions(const char* a, const char* b) {
+  while (*a != '\0' || *b != '\0') {
+    char* endA;
+    char* endB;
+    long x = strtol(a, &endA, 10);
+    long y = strtol(b, &endB, 10);
+    if (x != y) {
+      return x < y ? -1 : 1;
+    }
+    if (endA == a && endB == b) {
+      break;                            //not a number, the rest counts as equal
+    }
+    a = *endA == '.' ? endA + 1 : endA;
+    b = *endB == '.' ? endB + 1 : endB;
+  }
+  return 0;
+}
+
+void otaFail(const char* error) {
+  LOG_ERROR("firmware update failed: %s", error);
+  strlcpy(otaError, error, sizeof(otaError));
+  otaState = OTA_FAILED;
+  otaReceiving = false;
+  otaHttp.end();
+  if (Update.isRunning()) {
+    Update.end();                       //unfinished, discards the partial image
+  }
+}
+
+//Fetch the manifest and start the download when it names a newer version
+void otaCheck() {
+  if (strlen(ota_url) == 0 || otaState == OTA_DOWNLOADING || otaState == OTA_DONE) {
+    return;
+  }
+  LOG_INFO("checking for a firmware update at %s", ota_url);
+  otaHttp.begin(otaClient, ota_url);
+  int code = otaHttp.GET();
+  if (code != 200) {
+    LOG_WARN("update manifest not available, http %d", code);
+    otaHttp.end();
+    return;
+  }
+  //the whole manifest is read into RAM, a wrong url could point at something large
+  int manifestSize = otaHttp.getSize();
+  if (manifestSize < 0 || manifestSize > OTA_MANIFEST_MAX_SIZE) {
+    otaFail(manifestSize < 0 ? "manifest without a content length" : "manifest too large");
+    return;
+  }
+  String body = otaHttp.getString();
+  otaHttp.end();
+
+  DynamicJsonBuffer jsonBuffer;
+  JsonObject& json = jsonBuffer.parseObject(body);
+  const char* version = json["version"];
+  const char* url = json["url"];
+  const char* md5 = json["md5"];
+  uint32_t size = json["size"];
+  if (!json.success() || version == NULL || url == NULL || md5 == NULL || strlen(md5) != 32 || size == 0) {
+    otaFail("invalid manifest");
+    return;
+  }
+
+  if (compareVersions(version, currentFirmwareVersion.c_str()) <= 0) {
+    LOG_INFO("firmware %s is up to date, the server has %s", currentFirmwareVersion.c_str(), version);
+    otaState = OTA_IDLE;
+    return;
+  }
+
+  strlcpy(otaVersion, version, sizeof(otaVersion));
+  strlcpy(otaImageUrl, url, sizeof(otaImageUrl));
+  strlcpy(otaMd5, md5, sizeof(otaMd5));
+  otaSize = size;
+  otaStart();
+}
+
+void otaStart() {
+  LOG_INFO("updating firmware %s to %s, %u bytes", currentFirmwareVersion.c_str(), otaVersion, otaSize);
+  if (!Update.begin(otaSize)) {
+    otaFail(Update.getErrorString().c_str());
+    return;
+  }
+  Update.setMD5(otaMd5);
+  otaOffset = 0;
+  otaRetries = 0;
+  otaError[0] = '\0';
+  otaState = OTA_DOWNLOADING;
+  scheduler.once(otaChunkTask, 0);
+}
+
+//True when a Content-Range of "bytes <start>-<end>/<size>" starts at offset
+bool otaRangeStartsAt(const char* contentRange, uint32_t offset) {
+  if (strncmp(contentRange, "bytes ", 6) != 0) {
+    return false;
+  }
+  char* end;
+  unsigned long start = strtoul(contentRange + 6, &end, 10);
+  return end != contentRange + 6 && *end == '-' && start == offset;
+}
+
+//Try the range again at otaOffset later, everything before it is in flash already
+void otaRetry(int code) {
+  otaReceiving = false;
+  otaHttp.end();
+  if (++otaRetries > OTA_MAX_RETRIES) {
+    otaFail("download keeps failing");
+    return;
+  }
+  LOG_WARN("firmware download interrupted at %u of %u bytes (http %d), retrying", otaOffset, otaSize, code);
+  scheduler.once(otaChunkTask, OTA_RETRY_DELAY);
+}
+
+//Send the request of the next range, true when its body can be read
+bool otaRequestChunk() {
+  otaChunkEnd = otaOffset + min((uint32_t)OTA_CHUNK_SIZE, otaSize - otaOffset);
+  char range[32];
+  snprintf(range, sizeof(range), "bytes=%u-%u", otaOffset, otaChunkEnd - 1);
+  otaHttp.begin(otaClient, otaImageUrl);
+  otaHttp.addHeader("Range", range);
+  otaHttp.collectHeaders(otaCollectedHeaders, 1);
+  int code = otaHttp.GET();
+  if (code == 200 || code == 416) {
+    otaFail("update server does not support range requests");
+    return false;
+  }
+  if (code != 206) {
+    otaRetry(code);
+    return false;
+  }
+  //a range that starts anywhere else would put the bytes at the wrong place in flash
+  if (!otaRangeStartsAt(otaHttp.header("Content-Range").c_str(), otaOffset)) {
+    otaFail("update server sent the wrong range");
+    return false;
+  }
+  otaReceiving = true;
+  otaChunkStart = millis();
+  return true;
+}
+
+//Flash what has arrived of the open range, request the next range when it is complete
+void otaDownloadChunk() {
+  if (otaState != OTA_DOWNLOADING) {
+    return;
+  }
+  PROBE_SECTION(SECTION_OTA_CHUNK);
+  if (!otaReceiving && !otaRequestChunk()) {
+    return;
+  }
+
+  WiFiClient* stream = otaHttp.getStreamPtr();
+  if (stream == NULL) {
+    otaRetry(206);
+    return;
+  }
+  uint8_t buffer[512];
+  size_t available;
+  while (otaOffset < otaChunkEnd && (available = stream->available()) > 0) {
+    size_t read = stream->readBytes(buffer, min(available, min(sizeof(buffer), (size_t)(otaChunkEnd - otaOffset))));
+    if (Update.write(buffer, read) != read) {
+      otaFail(Update.getErrorString().c_str());
+      return;
+    }
+    otaOffset += read;
+  }
+
+  if (otaOffset < otaChunkEnd) {
+    if (!stream->connected() || millis() - otaChunkStart >= OTA_CHUNK_TIMEOUT) {
+      otaRetry(206);
+      return;
+    }
+    scheduler.once(otaChunkTask, OTA_READ_INTERVAL);     //the rest has not arrived yet
+    return;
+  }
+  otaReceiving = false;
+  otaHttp.end();
+  otaRetries = 0;
+
+  if (otaOffset < otaSize) {
+    scheduler.once(otaChunkTask, OTA_CHUNK_INTERVAL);
+    return;
+  }
+
+  //checks the md5 and marks the image for the bootloader
+  if (!Update.end()) {
+    otaFail(Update.getErrorString().c_str());
+    return;
+  }
+  LOG_INFO("firmware %s downloaded, restarting", otaVersion);
+  otaState = OTA_DONE;
+  scheduler.once(otaRestartTask, 1000);
+}
+
+void otaRestart() {
+  //settings changed within the last CONFIG_SAVE_DELAY are not in flash yet
+  if (configDirty) {
+    saveConfig();
+  }
+  logFlush();
+  ESP.restart();
+}
+
+//Update state: GET /api/ota
+void handleOta() {
+  char response[256];
+  snprintf(response, sizeof(response),
+           "{\"state\":\"%s\",\"current\":\"%s\",\"available\":\"%s\",\"offset\":%u,\"size\":%u,\"error\":\"%s\"}",
+           otaStateNames[otaState], currentFirmwareVersion.c_str(), otaVersion, otaOffset, otaSize, otaError);
+  server.send(200, "application/json", response);
+}
+
+//Check for an update now: POST /api/ota
+void handleOtaCheck() {
+  if (strlen(ota_url) == 0) {
+    server.send(400, "application/json", "{\"error\":\"no update manifest url configured\"}");
+    return;
+  }
+  scheduler.every(otaCheckTask, OTA_CHECK_INTERVAL, 0);
+  server.send(202, "application/json", "{\"checking\":true}");
+}
@@ -0,0 +1,128 @@
+/***************************************************************************
+ Config page rendering of the Salt sentry.
+
+ The page template is PROGMEM, with a table of its {n} placeholders, both
+ generated by tools/webassets.py from web/config.html. It is copied to a
+ small chunk buffer in large blocks and the placeholders are filled in
+ between, so the page is never searched or held in RAM as a whole. Every
+ full chunk goes to a sink: the web server in the firmware, a byte counter
+ in the host benchmark.
+
+ The settings form is not in the template, placeholder {PAGE_CONFIG_FORM}
+ becomes one input per field of the schema in config.h.
+ ***************************************************************************/
+#ifndef PAGE_H
+#define PAGE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+
+#define PAGE_CHUNK_SIZE  256        //stack buffer the page is streamed through
+#define PAGE_CONFIG_FORM 1          //placeholder of the settings form
+
+#ifndef PAGE_SLOT_DEFINED
+#define PAGE_SLOT_DEFINED
+struct PageSlot {
+  uint16_t offset;
+  uint8_t  length;
+  uint8_t  id;
+};
+#endif
+
+//input type of each ConfigFieldType in the settings form
+static const char* const configInputTypes[] = { "text", "password", "number", "number", "url" };
+static_assert(sizeof(configInputTypes) / sizeof(configInputTypes[0]) == CONFIG_URL + 1, "an input type for every ConfigFieldType");
+
+class PageWriter {
+  public:
+    explicit PageWriter(void (*sink)(const char* data, size_t length)) : _sink(sink), _used(0) {}
+
+    //Append to the chunk, sending it whenever it fills up
+    void append(const char* data, size_t length, bool progmem = false) {
+      while (length > 0) {
+        if (_used == PAGE_CHUNK_SIZE) {
+          flush();
+        }
+        size_t n = length < PAGE_CHUNK_SIZE - _used ? length : PAGE_CHUNK_SIZE - _used;
+        if (progmem) {
+          memcpy_P(_chunk + _used, data, n);
+        } else {
+          memcpy(_chunk + _used, data, n);
+        }
+        _used += n;
+        data += n;
+        length -= n;
+      }
+    }
+
+    void append(const char* text) {
+      append(text, strlen(text));
+    }
+
+    //Append text as an attribute value, a quote in a setting must not end the attribute
+    void appendAttribute(const char* text) {
+      for (const char* c = text; *c != '\0'; c++) {
+        switch (*c) {
+          case '&':  append("&amp;");  break;
+          case '<':  append("&lt;");   break;
+          case '\'': append("&#39;");  break;
+          case '"':  append("&quot;"); break;
+          default:   append(c, 1);
+        }
+      }
+    }
+
+    void flush() {
+      if (_used > 0) {
+        _sink(_chunk, _used);
+        _used = 0;
+      }
+    }
+
+  private:
+    void (*_sink)(const char* data, size_t length);
+    char _chunk[PAGE_CHUNK_SIZE];
+    size_t _used;
+};
+
+//Copy the template to out, placeholder {n} is filled in by fill(out, n)
+inline void renderPage(PageWriter& out, PGM_P page, const PageSlot* slots, size_t slotCount, void (*fill)(PageWriter&, int)) {
+  size_t position = 0;
+  for (size_t i = 0; i < slotCount; i++) {
+    PageSlot slot;
+    memcpy_P(&slot, &slots[i], sizeof(slot));
+    out.append(page + position, slot.offset - position, true);
+    fill(out, slot.id);
+    position = slot.offset + slot.length;
+  }
+  out.append(page + position, strlen_P(page + position), true);
+  out.flush();
+}
+
+//The settings form, the help text, label and input of every field of the schema
+inline void renderConfigForm(PageWriter& out, ConfigRecord& record) {
+  for (const ConfigField& field : configFields) {
+    if (field.help != nullptr) {
+      out.append(field.help);
+    }
+    char maxlength[4];
+    snprintf(maxlength, sizeof(maxlength), "%u", (unsigned)(field.size - 1));
+    out.append(field.label);
+    out.append(": <input type='");
+    out.append(configInputTypes[field.type]);
+    out.append("' name='");
+    out.append(field.key);
+    out.append("' maxlength='");
+    out.append(maxlength);
+    out.append("' value='");
+    out.appendAttribute(configValue(record, field));
+    out.append("'><br />");
+  }
+}
+
+#endif
@@ -0,0 +1,231 @@
+/***************************************************************************
+ Cooperative task scheduler of the Salt sentry.
+
+ Every piece of work in loop() is a Task with its own deadline. Armed tasks
+ sit in a hashed timer wheel of SCHEDULER_SLOTS slots of SCHEDULER_TICK_MS,
+ so a slice only looks at the slots whose tick has passed instead of at every
+ task. Tasks that are due move to a ready list ordered by priority and run
+ until the time budget of the slice is used up; whatever is left runs in the
+ next slice, highest priority first. runSlice() returns how long nothing is
+ due, so the loop can idle (and the SDK can sleep the radio) until then.
+
+ Tasks are plain structs owned by the caller, nothing is allocated.
+ ***************************************************************************/
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define SCHEDULER_TICK_MS   10
+#define SCHEDULER_SLOTS     64      //power of two, one wheel round is 640 ms
+#define SCHEDULER_MAX_TASKS 24      //registered tasks, for the statistics only (18 in the sketch)
+
+enum TaskPriority : uint8_t {
+  PRIORITY_LOW,
+  PRIORITY_NORMAL,
+  PRIORITY_HIGH
+};
+
+struct Task {
+  const char*  name;
+  void       (*run)();
+  TaskPriority priority;
+
+  uint32_t     interval;      //ms, 0 for a one-shot timer
+  uint32_t     due;           //ms, millis() based
+  bool         armed;         //in the wheel or in the ready list
+  Task*        next;
+
+  uint32_t     runs;
+  uint32_t     maxUs;         //longest run
+};
+
+class Scheduler {
+  public:
+    //run the task every interval ms, the first time after firstDelay ms
+    void every(Task& task, uint32_t interval, uint32_t firstDelay) {
+      task.interval = interval;
+      arm(task, millis() + firstDelay);
+    }
+
+    //run the task once after delay ms, rescheduling a task that is already armed
+    void once(Task& task, uint32_t delay) {
+      task.interval = 0;
+      arm(task, millis() + delay);
+    }
+
+    //register a task for the statistics before it is first armed, false when the table is full.
+    //Tasks are also registered when they are armed, this finds a full table at boot already
+    bool track(Task& task) {
+      for (size_t i = 0; i < _taskCount; i++) {
+        if (_tasks[i] == &task) {
+          return true;
+        }
+      }
+      if (_taskCount == SCHEDULER_MAX_TASKS) {
+        overflow = true;
+        return false;
+      }
+      _tasks[_taskCount++] = &task;
+      return true;
+    }
+
+    void cancel(Task& task) {
+      if (task.armed) {
+        unlink(task);
+      }
+    }
+
+    //Run due tasks until budgetUs is used (at least one task runs).
+    //Returns the ms until the next tick with work, 0 when tasks are still ready
+    uint32_t runSlice(uint32_t budgetUs) {
+      uint32_t now = millis();
+      collect(now);
+
+      uint32_t sliceStart = micros();
+      while (_ready != NULL) {
+        Task* task = _ready;
+        _ready = task->next;
+        task->armed = false;
+
+        uint32_t start = micros();
+        task->run();
+        uint32_t elapsed = micros() - start;
+        task->runs++;
+        if (elapsed > task->maxUs) {
+          task->maxUs = elapsed;
+        }
+
+        //periodic tasks keep their phase, runs missed while the loop was held up are skipped
+        if (task->interval != 0 && !task->armed) {
+          uint32_t next = task->due + task->interval;
+          uint32_t after = millis();
+          if ((int32_t)(next - after) < 0) {
+            next += ((after - next) / task->interval + 1) * task->interval;
+          }
+          arm(*task, next);
+        }
+
+        if (micros() - sliceStart >= budgetUs) {
+          if (_ready != NULL) {
+            overruns++;
+          }
+          break;
+        }
+      }
+      return _ready != NULL ? 0 : idleTime(now);
+    }
+
+    size_t taskCount() const {
+      return _taskCount;
+    }
+
+    const Task& task(size_t i) const {
+      return *_tasks[i];
+    }
+
+    uint32_t overruns = 0;    //slices that ended with tasks still ready
+    bool     overflow = false;  //a task did not fit SCHEDULER_MAX_TASKS, it runs but has no statistics
+
+  private:
+    Task*    _wheel[SCHEDULER_SLOTS] = { };
+    Task*    _ready = NULL;
+    uint32_t _tick = 0;       //last tick collected
+    bool     _started = false;
+    Task*    _tasks[SCHEDULER_MAX_TASKS];
+    size_t   _taskCount = 0;
+
+    //the first tick at whose start the task is due, a task due inside a tick waits for the end of it.
+    //Rounding down would file it under a tick that may already be collected while it was not due yet.
+    //64 bit, so a task due in the last ms before millis() wraps is filed after the last tick, not at 0
+    static uint32_t dueTick(uint32_t due) {
+      return ((uint64_t)due + SCHEDULER_TICK_MS - 1) / SCHEDULER_TICK_MS;
+    }
+
+    static size_t slot(uint32_t due) {
+      return dueTick(due) & (SCHEDULER_SLOTS - 1);
+    }
+
+    void arm(Task& task, uint32_t due) {
+      if (task.armed) {
+        unlink(task);
+      }
+      track(task);
+      task.due = due;
+      task.armed = true;
+      if (_started && (int32_t)(due - _tick * SCHEDULER_TICK_MS) <= 0) {
+        makeReady(task);      //its slot was already collected
+        return;
+      }
+      task.next = _wheel[slot(due)];
+      _wheel[slot(due)] = &task;
+    }
+
+    static bool removeFrom(Task** list, Task& task) {
+      for (Task** link = list; *link != NULL; link = &(*link)->next) {
+        if (*link == &task) {
+          *link = task.next;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void unlink(Task& task) {
+      if (!removeFrom(&_wheel[slot(task.due)], task)) {
+        removeFrom(&_ready, task);
+      }
+      task.armed = false;
+    }
+
+    //higher priority first, earlier deadline first within a priority
+    void makeReady(Task& task) {
+      Task** link = &_ready;
+      while (*link != NULL && ((*link)->priority > task.priority
+             || ((*link)->priority == task.priority && (int32_t)((*link)->due - task.due) <= 0))) {
+        link = &(*link)->next;
+      }
+      task.next = *link;
+      *link = &task;
+    }
+
+    //move the due tasks of every slot whose tick has passed to the ready list
+    void collect(uint32_t now) {
+      uint32_t nowTick = now / SCHEDULER_TICK_MS;
+      if (!_started) {
+        _started = true;
+        _tick = nowTick - SCHEDULER_SLOTS;
+      }
+      uint32_t ticks = nowTick - _tick;
+      if (ticks > SCHEDULER_SLOTS) {
+        ticks = SCHEDULER_SLOTS;      //one full round looks at every slot
+      }
+      for (uint32_t t = nowTick - ticks + 1; ticks > 0; t++, ticks--) {
+        Task** link = &_wheel[t & (SCHEDULER_SLOTS - 1)];
+        while (*link != NULL) {
+          Task* task = *link;
+          if ((int32_t)(task->due - now) <= 0) {
+            *link = task->next;
+            makeReady(*task);
+          } else {
+            link = &task->next;   //due in a later round
+          }
+        }
+      }
+      _tick = nowTick;
+    }
+
+    //ms until the next tick whose slot holds a task, at most one wheel round
+    uint32_t idleTime(uint32_t now) const {
+      for (uint32_t ahead = 1; ahead <= SCHEDULER_SLOTS; ahead++) {
+        if (_wheel[(_tick + ahead) & (SCHEDULER_SLOTS - 1)] != NULL) {
+          return (_tick + ahead) * SCHEDULER_TICK_MS - now;
+        }
+      }
+      return SCHEDULER_SLOTS * SCHEDULER_TICK_MS;
+    }
+};
+
+#endif
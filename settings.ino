@@ -1,6 +1,39 @@
+//Format a number for the config page, valid until the next call
+const char* formatPlaceholder(float value) {
+  static char buffer[12];
+  dtostrf(value, 1, 1, buffer);
+  return buffer;
+}
+
+//Fill placeholder {n} of the config page
+void configPlaceholder(PageWriter& out, int n) {
+  switch (n) {
+    case PAGE_CONFIG_FORM: renderConfigForm(out, config); break;
+    case 6:  out.append(mqtt_status); break;
+    case 11: out.append(currentFirmwareVersion.c_str()); break;
+    case 12: out.append(formatPlaceholder(lastPercentage)); break;
+    case 13: out.append(formatPlaceholder(lastMeasure)); break;
+  }
+}
+
+void sendPageChunk(const char* data, size_t length) {
+  server.sendContent(data, length);
+}
+
+//Stream a PROGMEM page template (see page.h) to the client using chunked transfer encoding
+void streamPage(PGM_P page, const PageSlot* slots, size_t slotCount, void (*fill)(PageWriter&, int)) {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/html", "");
+
+  PageWriter out(sendPageChunk);
+  renderPage(out, page, slots, slotCount, fill);
+  server.sendContent("");  //terminating chunk
+}
+
 //Handle webserver root request
 void handleRoot() {
-  Serial.println("Config page is requested");
+  HEAP_SITE("config_page");
+  LOG_DEBUG("Config page is requested");
   String addy = server.client().remoteIP().toString();
 
   //determine if this user is connected to the AP or comming from the network the device is connected to
@@ -8,20 +41,15 @@ void handleRoot() {
   if (addy == "192.168.4.2"){
       server.send(200, "text/html", "The Salt sentry can be configured on address http:// " + WiFi.localIP().toString() + " when connected to wifi network " + WiFi.SSID());
   } else {
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+    unsigned long start = micros();
+    uint32_t heapBefore = ESP.getFreeHeap();
+#endif
+
+    streamPage(config_page, config_page_slots, CONFIG_PAGE_SLOTS, configPlaceholder);
 
-      String configPage = FPSTR(config_page);
-    configPage.replace("{1}", mqtt_server);
-    configPage.replace("{2}", mqtt_port);
-    configPage.replace("{3}", mqtt_username);
-    configPage.replace("{4}", mqtt_password);
-    configPage.replace("{5}", mqtt_topic);
-    configPage.replace("{6}", mqtt_status);
-    configPage.replace("{7}", dz_idx);
-    configPage.replace("{8}", oh_itemid);
-    configPage.replace("{9}", min_range);
-    configPage.replace("{10}", max_range);
-    configPage.replace("{11}", currentFirmwareVersion);
-    
-    server.send(200, "text/html", configPage);
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+    LOG_DEBUG("Config page sent in %lu us, heap before/after: %u/%u", micros() - start, heapBefore, ESP.getFreeHeap());
+#endif
   }
 }
@@ -0,0 +1,38 @@
+/**************************************************************
+   Static asset table and handlers, see StaticAssets.h
+ **************************************************************/
+
+#include "StaticAssets.h"
+#include "StaticAssetsData.h"   // generated by tools/webassets.py
+
+const StaticAsset staticAssets[] = {
+  STATIC_ASSET_ENTRIES
+};
+
+const size_t staticAssetCount = sizeof(staticAssets) / sizeof(staticAssets[0]);
+
+static const char *etagHeader[] = { "If-None-Match" };
+
+void registerStaticAssets(ESP8266WebServer &server) {
+  server.collectHeaders(etagHeader, 1);
+  for (size_t i = 0; i < staticAssetCount; i++) {
+    ESP8266WebServer  *srv   = &server;
+    const StaticAsset *asset = &staticAssets[i];
+    server.on(asset->path, HTTP_GET, [srv, asset]() {
+      sendStaticAsset(*srv, *asset);
+    });
+  }
+}
+
+void sendStaticAsset(ESP8266WebServer &server, const StaticAsset &asset) {
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", "public, max-age=86400");
+  if (server.header("If-None-Match") == asset.etag) {
+    server.send(304);
+    return;
+  }
+  if (asset.gzipped) {
+    server.sendHeader("Content-Encoding", "gzip");
+  }
+  server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+}
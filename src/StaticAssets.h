@@ -0,0 +1,34 @@
+/**************************************************************
+   Static assets (logo, icons) for the Salt sentry web pages.
+
+   The assets are stored as binary PROGMEM blobs (gzip compressed
+   where that makes them smaller) and served from their own url
+   with a strong ETag, so browsers download them once and
+   revalidate with a 304 afterwards.
+ **************************************************************/
+
+#ifndef StaticAssets_h
+#define StaticAssets_h
+
+#include <ESP8266WebServer.h>
+
+struct StaticAsset {
+  const char    *path;
+  const char    *contentType;
+  const char    *etag;
+  const uint8_t *data;      // PROGMEM
+  size_t         length;
+  bool           gzipped;
+};
+
+extern const StaticAsset staticAssets[];
+extern const size_t      staticAssetCount;
+
+// Registers a GET handler for every asset. Also makes the server collect the
+// If-None-Match header, which replaces any earlier collectHeaders() call.
+void registerStaticAssets(ESP8266WebServer &server);
+
+// Sends the asset, or a 304 when the client already has this version
+void sendStaticAsset(ESP8266WebServer &server, const StaticAsset &asset);
+
+#endif
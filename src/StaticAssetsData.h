@@ -0,0 +1,246 @@
+/*
+ Generated by tools/webassets.py from web/, do not edit by hand.
+
+ Static asset blobs, included by StaticAssets.cpp only.
+ */
+
+// logo.jpg: 11215 bytes source, 3430 bytes gzipped
+static const uint8_t logo_jpg[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x96, 0x77, 0x54, 0x13, 0x4b,
+  0xbc, 0xc7, 0x37, 0x04, 0x12, 0x9a, 0x44, 0x7a, 0x53, 0x22, 0x22, 0x60, 0x03, 0xae, 0x48, 0x27,
+  0x06, 0x44, 0x45, 0xca, 0x85, 0x5c, 0x6a, 0x28, 0x02, 0x97, 0xde, 0xa4, 0x0a, 0x82, 0x18, 0x12,
+  0x01, 0x01, 0x41, 0x24, 0xd2, 0xbb, 0x11, 0xa4, 0x8a, 0x10, 0x95, 0x50, 0x44, 0x84, 0x1b, 0xaa,
+  0x88, 0x8a, 0x14, 0x41, 0xe2, 0x45, 0x42, 0x40, 0x54, 0x40, 0x4d, 0x14, 0x42, 0x24, 0x21, 0x79,
+  0xe1, 0xbe, 0x7a, 0xde, 0x79, 0x7f, 0xbc, 0xf7, 0xbe, 0x7b, 0xe6, 0x77, 0x76, 0xcf, 0xcc, 0xce,
+  0x7c, 0x3f, 0x3b, 0xf3, 0x9b, 0x1d, 0xde, 0x3b, 0x1e, 0x15, 0xd8, 0x6b, 0x63, 0x69, 0x6d, 0x09,
+  0x80, 0x40, 0x20, 0xc0, 0x8a, 0x7f, 0x01, 0xbc, 0xf7, 0xc0, 0x19, 0x40, 0x00, 0xb4, 0xab, 0xdd,
+  0x28, 0xb0, 0x2b, 0x41, 0xf0, 0x6e, 0x14, 0x12, 0x14, 0x04, 0x0b, 0x42, 0x84, 0x20, 0x90, 0x7f,
+  0x0a, 0x54, 0x44, 0x98, 0x5f, 0xa0, 0x10, 0x88, 0xb0, 0x98, 0xb0, 0x88, 0xe8, 0xae, 0xf8, 0x77,
+  0xe2, 0x62, 0xa2, 0xe2, 0xbb, 0x0f, 0xbb, 0x9d, 0xfc, 0xeb, 0xab, 0x02, 0x42, 0x60, 0xb0, 0x90,
+  0x28, 0x14, 0x02, 0x15, 0xfd, 0x3f, 0x8b, 0xf7, 0x17, 0x20, 0x29, 0x0c, 0x68, 0x00, 0xa5, 0x60,
+  0x90, 0x2a, 0x20, 0x20, 0x09, 0x02, 0x4b, 0x82, 0x78, 0x83, 0x00, 0x1c, 0x00, 0x40, 0x42, 0xff,
+  0xd8, 0x03, 0x01, 0xff, 0x26, 0x90, 0x00, 0x58, 0x50, 0x08, 0x02, 0xe5, 0xdb, 0x10, 0xe3, 0x37,
+  0x68, 0xdf, 0xcb, 0xb7, 0x0f, 0x06, 0xf3, 0x4d, 0x0b, 0xf1, 0x1d, 0xf3, 0x6b, 0x93, 0xf9, 0xf5,
+  0x80, 0xa0, 0xa4, 0x90, 0x94, 0xea, 0x89, 0xd3, 0x10, 0x69, 0x07, 0x5f, 0xe8, 0xc1, 0x18, 0x19,
+  0xdd, 0x94, 0xbc, 0x6a, 0x61, 0x35, 0x8b, 0x47, 0x64, 0x59, 0xc7, 0x09, 0xfa, 0xa1, 0x93, 0x7e,
+  0xb1, 0xa9, 0x22, 0xa2, 0x72, 0xf2, 0x0a, 0x8a, 0x4a, 0xea, 0x1a, 0x9a, 0x87, 0x8f, 0x1c, 0xd5,
+  0xd3, 0x37, 0x30, 0x34, 0x32, 0x36, 0x39, 0x73, 0xf6, 0x9c, 0xe5, 0x79, 0x2b, 0x6b, 0x1b, 0x27,
+  0x67, 0x17, 0x57, 0xb4, 0x9b, 0xbb, 0x87, 0x7f, 0x40, 0x60, 0x50, 0x70, 0x48, 0x68, 0xd8, 0xa5,
+  0xb8, 0xf8, 0xcb, 0x09, 0x89, 0x57, 0x92, 0xd2, 0xae, 0xa7, 0x67, 0x64, 0xde, 0xc8, 0xca, 0xce,
+  0x2f, 0x28, 0x2c, 0x2a, 0x2e, 0x29, 0x2d, 0x2b, 0xaf, 0xb9, 0x57, 0x5b, 0x57, 0xdf, 0xd0, 0xd8,
+  0x74, 0xff, 0x71, 0x1b, 0xa9, 0xbd, 0xa3, 0xb3, 0xeb, 0x49, 0x77, 0xff, 0xc0, 0xe0, 0xd0, 0xf0,
+  0xc8, 0xf3, 0xd1, 0x17, 0x93, 0x53, 0xd3, 0x6f, 0x67, 0x66, 0xdf, 0xcd, 0x51, 0x16, 0x69, 0x4b,
+  0xcb, 0x1f, 0x57, 0x3e, 0x7d, 0xfe, 0xb2, 0xca, 0xf8, 0xf1, 0x73, 0x63, 0x93, 0xb9, 0xc5, 0xfa,
+  0xb5, 0xbd, 0xcb, 0x05, 0x02, 0xc0, 0xa0, 0x7f, 0xd7, 0xff, 0xc8, 0x25, 0xc9, 0xe7, 0x12, 0xd8,
+  0x9d, 0x03, 0xe8, 0x2e, 0x17, 0x48, 0x20, 0x61, 0xb7, 0x81, 0xa4, 0xa0, 0x90, 0xea, 0x09, 0x88,
+  0xd4, 0x69, 0x07, 0xa8, 0x6f, 0x8c, 0xf4, 0x41, 0xdd, 0x14, 0x61, 0x19, 0x8b, 0xbc, 0xea, 0x47,
+  0x64, 0x11, 0xb5, 0x93, 0x8e, 0x74, 0x59, 0xbf, 0xd8, 0x09, 0x51, 0xb9, 0x43, 0x7a, 0x8b, 0xea,
+  0x8c, 0x5d, 0xb4, 0x7f, 0xc8, 0xfe, 0x77, 0x60, 0xa9, 0xff, 0x2f, 0xb2, 0xff, 0x00, 0xfb, 0x4f,
+  0x2e, 0x0a, 0x20, 0x0e, 0x06, 0xf1, 0x27, 0x0f, 0x2c, 0x09, 0x98, 0x01, 0x3b, 0x01, 0x3b, 0x44,
+  0x1e, 0x10, 0x35, 0xb4, 0x53, 0x64, 0x16, 0x86, 0x4b, 0x83, 0x83, 0xf5, 0x5f, 0x1d, 0x3b, 0x93,
+  0x39, 0xc0, 0x03, 0xa4, 0xbe, 0xb5, 0x0b, 0x6f, 0x12, 0xa5, 0xd6, 0x3c, 0x1a, 0xe6, 0xd0, 0xd6,
+  0xb6, 0x21, 0x13, 0x45, 0xe4, 0x8b, 0x1a, 0x0a, 0x1d, 0x48, 0x3f, 0xa8, 0xfd, 0x4a, 0xcf, 0xcc,
+  0x16, 0x57, 0x2c, 0x8b, 0x6d, 0x96, 0x18, 0x8d, 0x89, 0x9f, 0xc6, 0x58, 0x37, 0x7c, 0x99, 0x74,
+  0xc3, 0xec, 0x7f, 0x1b, 0xc7, 0xf6, 0xda, 0x1f, 0x87, 0x93, 0xf5, 0x18, 0x8f, 0xa1, 0x7d, 0xfe,
+  0x16, 0x18, 0x42, 0xf1, 0xd4, 0xf3, 0xab, 0xbe, 0x1e, 0x70, 0xcc, 0x60, 0x26, 0x5a, 0x66, 0x39,
+  0xcf, 0x7c, 0xbf, 0x46, 0x03, 0x0f, 0x10, 0x4a, 0xdd, 0x21, 0x50, 0x77, 0xea, 0xb8, 0x8a, 0x1c,
+  0xc9, 0xa9, 0xf6, 0xbe, 0x3d, 0xd6, 0x35, 0x18, 0x73, 0x7a, 0x4e, 0xf9, 0xeb, 0x6a, 0xda, 0x68,
+  0x8f, 0x7f, 0x58, 0x5e, 0x88, 0xae, 0xf0, 0xfc, 0xcc, 0x0c, 0x55, 0xc0, 0x21, 0xc0, 0xd4, 0x9c,
+  0x1c, 0x6f, 0x1c, 0x99, 0xd9, 0xe7, 0xcb, 0x03, 0x04, 0x97, 0x77, 0x9e, 0xe8, 0xa3, 0xde, 0x57,
+  0x0c, 0xc0, 0xf7, 0x72, 0x9c, 0x70, 0x8b, 0xc9, 0x86, 0x76, 0x9d, 0x74, 0xdc, 0x60, 0xcb, 0x99,
+  0x01, 0x8f, 0x00, 0x8a, 0xcb, 0xcf, 0x0b, 0xe7, 0x71, 0x11, 0x02, 0xc3, 0x13, 0x7f, 0x7f, 0x43,
+  0x04, 0x0e, 0x96, 0xfd, 0x8a, 0xed, 0x22, 0x43, 0xcb, 0x81, 0x6d, 0xc3, 0xd8, 0xed, 0xc9, 0x6f,
+  0x2a, 0x24, 0xa0, 0xa2, 0x44, 0xf1, 0x95, 0x72, 0xc9, 0xcc, 0xb5, 0x3d, 0x63, 0x6b, 0xb6, 0x77,
+  0x4e, 0x9a, 0x43, 0x16, 0x73, 0x56, 0xb2, 0x01, 0xbb, 0xb1, 0x35, 0x1b, 0x2b, 0x19, 0x20, 0x58,
+  0x2f, 0x20, 0xe9, 0x0d, 0xe0, 0x26, 0x61, 0x7d, 0x4f, 0x0f, 0x08, 0xca, 0x06, 0x58, 0x25, 0x5c,
+  0x51, 0x02, 0xfd, 0x0c, 0xd9, 0x8c, 0x24, 0x3f, 0x84, 0x4f, 0xe7, 0x01, 0xe2, 0x9c, 0x33, 0x74,
+  0x9f, 0xfe, 0xde, 0x63, 0xd3, 0xed, 0x42, 0xd3, 0x07, 0x27, 0x03, 0x18, 0x67, 0xb7, 0xf2, 0x46,
+  0xc2, 0xac, 0xb2, 0x4a, 0x21, 0x1d, 0x65, 0x46, 0xaa, 0x90, 0x58, 0xe5, 0xdb, 0x27, 0x72, 0xc3,
+  0x87, 0x22, 0x79, 0x00, 0x35, 0xdb, 0xe3, 0x32, 0x21, 0x5c, 0x7d, 0xf3, 0xd3, 0x3a, 0x9e, 0x6e,
+  0xa9, 0xe0, 0xef, 0x35, 0x39, 0x6a, 0x78, 0x43, 0xbf, 0xc8, 0xd9, 0x7b, 0xb9, 0x20, 0xe6, 0x9a,
+  0x50, 0x72, 0x07, 0x54, 0xa8, 0xdf, 0x39, 0x76, 0x55, 0xfa, 0xa5, 0x3a, 0x9a, 0xe2, 0x6c, 0xc7,
+  0xae, 0x6c, 0xf1, 0x2c, 0x1b, 0x8a, 0x24, 0x26, 0xc3, 0xc6, 0x7e, 0x8a, 0x4f, 0x0d, 0x8a, 0xdb,
+  0xc7, 0x64, 0xd7, 0x15, 0x9e, 0x81, 0xad, 0x87, 0x8c, 0x5a, 0x6e, 0x1a, 0x17, 0x12, 0x47, 0x15,
+  0x4d, 0xe7, 0x28, 0x94, 0xef, 0x77, 0x37, 0x79, 0x40, 0xea, 0x21, 0xf3, 0xe7, 0x87, 0xe0, 0x8f,
+  0xa1, 0x64, 0xaf, 0xba, 0x58, 0xc5, 0xf8, 0xf9, 0x70, 0x02, 0x8e, 0xc5, 0x22, 0xd6, 0xe0, 0xa8,
+  0x85, 0xbd, 0xb2, 0x2c, 0x1c, 0x3d, 0x8d, 0x1a, 0x9c, 0xab, 0x87, 0x12, 0xe5, 0xe8, 0x4e, 0x20,
+  0x34, 0xc3, 0xef, 0xb1, 0x26, 0xbf, 0xc6, 0x9b, 0xa2, 0x60, 0xcf, 0x5e, 0xde, 0x1e, 0xd5, 0x73,
+  0xa5, 0x37, 0x8f, 0x95, 0x7d, 0xcc, 0xcb, 0xea, 0x5f, 0x4a, 0x85, 0xc8, 0xc4, 0x54, 0x4e, 0x2f,
+  0xd1, 0x11, 0x3a, 0x3e, 0x5a, 0x55, 0x17, 0x1e, 0xbb, 0x78, 0x59, 0x19, 0x11, 0x71, 0xc5, 0x33,
+  0x05, 0x9d, 0x76, 0x91, 0xa1, 0x45, 0x2b, 0x9c, 0xf8, 0xf4, 0xd7, 0x4d, 0x7f, 0xbc, 0x5e, 0x3c,
+  0xed, 0x58, 0x19, 0x34, 0x55, 0xf7, 0x7a, 0x9e, 0x5a, 0xc0, 0xb6, 0x9f, 0xe9, 0x2c, 0xae, 0x5f,
+  0xb8, 0xc6, 0x03, 0x22, 0x08, 0xb9, 0x3c, 0x40, 0xa6, 0x1a, 0x3f, 0xe2, 0xb3, 0x87, 0x07, 0x04,
+  0xd6, 0xbf, 0xed, 0x81, 0x1b, 0x34, 0x31, 0x8d, 0xbe, 0xb5, 0x70, 0xac, 0xe5, 0xdf, 0x17, 0x61,
+  0x5e, 0x65, 0xa0, 0xd3, 0x04, 0x1b, 0xa1, 0xf9, 0x26, 0xa0, 0xd1, 0x8b, 0x97, 0xbc, 0x2b, 0xd8,
+  0x4e, 0xdc, 0x37, 0x69, 0xcc, 0x58, 0x96, 0xfd, 0x07, 0xd3, 0xce, 0x37, 0x68, 0xc7, 0xe9, 0xd6,
+  0x28, 0xd5, 0xb6, 0xc9, 0x38, 0xc2, 0x6f, 0x4d, 0x4f, 0xba, 0x6e, 0xef, 0xbc, 0x6c, 0xd4, 0x4c,
+  0x17, 0x4f, 0x14, 0xac, 0x44, 0x23, 0x8f, 0x65, 0x46, 0x3b, 0xb7, 0x85, 0x29, 0x28, 0x19, 0xe5,
+  0x5e, 0xb1, 0xfe, 0x31, 0x3e, 0x1f, 0x9e, 0xf7, 0x25, 0x79, 0xcb, 0x93, 0xc4, 0xc9, 0xad, 0x84,
+  0x29, 0xae, 0xb8, 0x74, 0xe1, 0x64, 0xcb, 0x69, 0xd1, 0xd8, 0xd7, 0x7b, 0xf1, 0xa7, 0x34, 0x5f,
+  0xd7, 0xde, 0xd7, 0x20, 0x68, 0x53, 0x1a, 0xae, 0x7a, 0x45, 0xb6, 0xc2, 0x21, 0x3c, 0x20, 0xa4,
+  0x19, 0x96, 0x83, 0x6b, 0x6b, 0x64, 0x2d, 0xd4, 0x7e, 0x99, 0x18, 0x88, 0x91, 0x20, 0xc4, 0xa8,
+  0x33, 0x4b, 0x27, 0x0b, 0x96, 0xbd, 0xcc, 0x95, 0x31, 0x87, 0x96, 0x4e, 0xa1, 0x73, 0xae, 0x59,
+  0xfd, 0x79, 0xf5, 0x2d, 0x3c, 0xa5, 0x0f, 0x8e, 0xb9, 0xc4, 0x98, 0x62, 0x06, 0xfb, 0xe4, 0x70,
+  0x95, 0xe8, 0xea, 0xd5, 0xb3, 0x91, 0x6a, 0x4f, 0x95, 0xb0, 0x99, 0x3b, 0xd5, 0x1d, 0x47, 0x02,
+  0xb3, 0x2d, 0xcf, 0x9d, 0x39, 0x06, 0x22, 0x19, 0x7c, 0xb0, 0xde, 0x17, 0xd4, 0xb5, 0xb6, 0x4c,
+  0xa2, 0x3f, 0x7a, 0xb0, 0x66, 0x57, 0x67, 0x7f, 0xbf, 0x7e, 0xa3, 0x17, 0x5f, 0xfe, 0x63, 0x93,
+  0x74, 0x79, 0x35, 0xc9, 0xcd, 0x5b, 0xa3, 0xa5, 0x14, 0xa1, 0x17, 0xbd, 0x31, 0x15, 0xdf, 0x68,
+  0x73, 0x1f, 0xdd, 0xd9, 0xf3, 0x44, 0x0a, 0x5f, 0xf7, 0x31, 0x7c, 0xe3, 0xd1, 0x8a, 0x09, 0xfa,
+  0x2b, 0x9e, 0xed, 0x15, 0x6e, 0x26, 0xaf, 0x0f, 0x4b, 0x99, 0x81, 0xb7, 0x69, 0x5c, 0xfb, 0x70,
+  0x70, 0x72, 0xe3, 0x63, 0x5f, 0x0f, 0x89, 0x07, 0x5c, 0x6f, 0xb2, 0xa8, 0x15, 0xbc, 0x2b, 0x0e,
+  0x57, 0x46, 0x2d, 0x78, 0x83, 0xc6, 0xf5, 0xbf, 0xfa, 0xc0, 0x7b, 0x91, 0x5f, 0xcc, 0xda, 0x7c,
+  0xd6, 0x3f, 0xd1, 0x74, 0x28, 0xf2, 0x34, 0x24, 0x1e, 0x51, 0xcc, 0x95, 0xa7, 0xb3, 0xc3, 0x4c,
+  0x8a, 0x09, 0x7e, 0xe4, 0xaa, 0x79, 0x67, 0xec, 0x17, 0x91, 0xa5, 0x12, 0xd5, 0x04, 0x15, 0xe3,
+  0x57, 0xa1, 0x83, 0xc6, 0xde, 0x4e, 0x45, 0xec, 0xc3, 0x8b, 0xc7, 0xba, 0x73, 0x1d, 0x1c, 0x13,
+  0xf0, 0x5a, 0x05, 0xd6, 0x43, 0x9c, 0x59, 0xfb, 0x0c, 0x0c, 0x9c, 0x10, 0xfc, 0x8b, 0x46, 0x3c,
+  0x3e, 0x20, 0xa6, 0x74, 0x54, 0x2a, 0xfa, 0x42, 0xdb, 0x4a, 0x4f, 0x0d, 0x25, 0xff, 0x47, 0x47,
+  0xf9, 0xfa, 0x36, 0x5c, 0x8f, 0x3b, 0xca, 0x03, 0xe8, 0x0e, 0x3a, 0xef, 0xef, 0x31, 0x53, 0x19,
+  0x86, 0x29, 0x9c, 0x33, 0x34, 0x1f, 0x96, 0xe6, 0x83, 0xcb, 0x38, 0x09, 0xec, 0x81, 0xd1, 0xa7,
+  0xb6, 0x8c, 0x8c, 0xb4, 0xa5, 0xf7, 0x57, 0x57, 0x26, 0x5b, 0x5e, 0xe8, 0xa5, 0x7a, 0xbe, 0xeb,
+  0x4f, 0x53, 0xa0, 0x3c, 0x93, 0xe8, 0xf7, 0x14, 0x06, 0xc5, 0xca, 0xfc, 0xe8, 0x15, 0xe6, 0x2f,
+  0xa6, 0x32, 0x1c, 0xf9, 0x1c, 0xf2, 0x14, 0xc7, 0x99, 0x55, 0x45, 0x5d, 0x98, 0x4b, 0x63, 0xca,
+  0xd2, 0xf1, 0x59, 0x1b, 0xf8, 0x0c, 0x2e, 0x72, 0x1a, 0x71, 0x32, 0xfe, 0x7e, 0x98, 0x0a, 0xd2,
+  0x56, 0x51, 0xfd, 0xea, 0x95, 0x2a, 0xc9, 0x6c, 0x1b, 0xe8, 0xf1, 0x6c, 0x85, 0xaf, 0xcf, 0x05,
+  0x97, 0xf4, 0x7f, 0x06, 0x53, 0x0a, 0xb0, 0xb3, 0x66, 0x74, 0x37, 0xdc, 0x4d, 0xf8, 0xc3, 0xf8,
+  0x11, 0xf2, 0x7b, 0x33, 0x4a, 0x26, 0xf3, 0xe2, 0xc3, 0xa9, 0xd6, 0x9e, 0x98, 0xa8, 0x78, 0xb3,
+  0xdc, 0xe3, 0x71, 0xb8, 0xbd, 0xc9, 0xf7, 0xed, 0x24, 0x8c, 0x5a, 0xcf, 0xfa, 0xb6, 0xcc, 0x39,
+  0xd7, 0x8d, 0x7c, 0x2b, 0x0b, 0x38, 0x90, 0x37, 0x3e, 0x56, 0x39, 0xdb, 0x82, 0x09, 0xe4, 0x0f,
+  0x98, 0x75, 0x8e, 0xca, 0x03, 0x28, 0x97, 0xa8, 0x30, 0xb2, 0x4f, 0x3a, 0x76, 0xdf, 0x24, 0xc6,
+  0x61, 0x91, 0x07, 0xe4, 0xca, 0x25, 0x15, 0xbd, 0x25, 0x66, 0xa9, 0x4d, 0x97, 0x61, 0x4a, 0x5b,
+  0xbe, 0x4e, 0x86, 0x94, 0x1f, 0x90, 0xc9, 0x84, 0x75, 0x81, 0xbb, 0x52, 0x91, 0x3d, 0x4e, 0x0f,
+  0x55, 0xa4, 0x19, 0xca, 0x5c, 0xd1, 0x2c, 0xfe, 0xfe, 0x80, 0x64, 0xf9, 0xb0, 0xcd, 0x13, 0x4d,
+  0x99, 0x21, 0x8c, 0xf3, 0x1c, 0xe9, 0x25, 0x72, 0x5e, 0x22, 0x71, 0x64, 0x2d, 0x41, 0x33, 0xfd,
+  0x78, 0x09, 0xcd, 0x44, 0x77, 0xfe, 0x7c, 0x64, 0xce, 0x0f, 0xb9, 0xdb, 0xda, 0xcf, 0xe9, 0xf7,
+  0xed, 0x15, 0x72, 0x98, 0xad, 0x99, 0x4b, 0x68, 0x8e, 0xcc, 0x18, 0xf3, 0x2b, 0xcb, 0x93, 0x91,
+  0xb0, 0xe8, 0xb3, 0xfe, 0xaa, 0x1e, 0x3b, 0xc4, 0x95, 0xef, 0x65, 0x55, 0x30, 0xa0, 0x03, 0x86,
+  0xe5, 0x55, 0x5b, 0x99, 0x1a, 0x8c, 0xbf, 0xac, 0x8e, 0x07, 0x64, 0xd0, 0x16, 0xcf, 0x86, 0xc6,
+  0xca, 0x0c, 0x53, 0xc9, 0xc2, 0x05, 0x31, 0x6a, 0xc5, 0xef, 0xa7, 0x9d, 0x1e, 0x2a, 0xe1, 0xc4,
+  0x70, 0xd4, 0x06, 0x5c, 0xbb, 0x59, 0x0e, 0x22, 0x9c, 0x71, 0x92, 0xe9, 0xc7, 0x4a, 0x63, 0xab,
+  0xb8, 0x27, 0x06, 0x2f, 0xf9, 0xa4, 0xf4, 0xc8, 0x61, 0x50, 0x35, 0xac, 0x40, 0x8c, 0x1d, 0x73,
+  0x6d, 0x4f, 0xd2, 0x84, 0xc7, 0xf1, 0x1a, 0x3b, 0xa9, 0xc0, 0x7d, 0x59, 0x2e, 0x68, 0x65, 0x72,
+  0x10, 0x99, 0x2c, 0xe8, 0xea, 0xdd, 0xc4, 0xb7, 0xd8, 0x43, 0x7f, 0xfb, 0x7d, 0xdd, 0x8c, 0xba,
+  0x80, 0xc7, 0xc1, 0xb0, 0xf2, 0x23, 0x0f, 0x30, 0x28, 0x46, 0x49, 0xb6, 0x74, 0xff, 0x36, 0xae,
+  0x7f, 0x73, 0xda, 0xf3, 0x15, 0xde, 0x0d, 0x2d, 0x86, 0xb8, 0x68, 0x51, 0x86, 0x68, 0x77, 0x75,
+  0x85, 0x06, 0xa1, 0xaa, 0x14, 0x8c, 0x46, 0xf5, 0x40, 0x5b, 0x9a, 0xa9, 0x9f, 0x18, 0x2e, 0xe3,
+  0xe9, 0x7a, 0xef, 0x89, 0xfb, 0xf8, 0x1b, 0xf2, 0x9a, 0xa3, 0xdb, 0xe0, 0x76, 0x4b, 0x2b, 0x41,
+  0x0d, 0xb1, 0xf7, 0x6f, 0x19, 0xc8, 0x59, 0xcb, 0x48, 0x77, 0x97, 0xc7, 0xe0, 0xbd, 0xba, 0x90,
+  0xc4, 0x2f, 0xe7, 0xac, 0xe0, 0xa6, 0xdc, 0x19, 0x79, 0x49, 0x0f, 0xee, 0xdc, 0x82, 0xa0, 0x76,
+  0xeb, 0x21, 0x91, 0x7d, 0x09, 0x4a, 0x37, 0x4d, 0x0d, 0x03, 0x25, 0x05, 0xec, 0x2e, 0x25, 0xf1,
+  0x80, 0x2c, 0x8e, 0x3b, 0x7f, 0x7c, 0x15, 0xc6, 0xab, 0xad, 0x01, 0xbc, 0xc0, 0x9a, 0xa1, 0x89,
+  0x66, 0x3f, 0x11, 0x36, 0x2f, 0x38, 0xdb, 0x6e, 0x85, 0xb5, 0xad, 0xf2, 0xa3, 0x8a, 0xdf, 0x28,
+  0x42, 0x1d, 0x2d, 0x23, 0x93, 0xf7, 0x03, 0x7e, 0xba, 0xce, 0xb0, 0x37, 0xba, 0xdb, 0x71, 0x74,
+  0x16, 0x02, 0x19, 0xec, 0xee, 0xad, 0x77, 0xc4, 0xa0, 0x80, 0xed, 0x14, 0xaf, 0x71, 0xf7, 0x99,
+  0x4e, 0xf3, 0x86, 0xd9, 0xfe, 0x57, 0xcd, 0x33, 0xc3, 0x41, 0x6e, 0x2f, 0xf1, 0x30, 0x4d, 0x45,
+  0xda, 0x5a, 0xe3, 0x13, 0xad, 0x25, 0x7b, 0xbd, 0xa6, 0xee, 0x5b, 0x57, 0xda, 0x6b, 0x36, 0xf5,
+  0x91, 0xe2, 0x18, 0x1f, 0xfe, 0xc7, 0x38, 0x86, 0x71, 0x78, 0xb4, 0x93, 0xcf, 0xcf, 0xbe, 0x53,
+  0x7f, 0xae, 0x76, 0x47, 0xd6, 0x1a, 0xb0, 0x60, 0x43, 0x47, 0x13, 0x10, 0x79, 0x91, 0x94, 0xe2,
+  0x9f, 0x3a, 0x1f, 0xa0, 0x35, 0xa9, 0x97, 0x48, 0x8c, 0xfc, 0xae, 0x83, 0x5b, 0x1c, 0xe9, 0x8e,
+  0xa0, 0x34, 0x32, 0x5c, 0xa6, 0x55, 0xed, 0xe1, 0xd5, 0x9a, 0x3e, 0xa9, 0x4d, 0x4b, 0x4f, 0x37,
+  0x46, 0xf7, 0x85, 0x43, 0xc1, 0x7f, 0x8e, 0x82, 0x35, 0xef, 0x8e, 0x82, 0xcb, 0x73, 0xc6, 0xc4,
+  0x2c, 0x8c, 0x8e, 0x5b, 0x1e, 0xcd, 0x7c, 0x6a, 0xdf, 0xdd, 0x60, 0x44, 0xfc, 0xd8, 0x43, 0xc9,
+  0xff, 0x65, 0x6d, 0x7a, 0xc5, 0xad, 0x07, 0xbf, 0x3f, 0xeb, 0x4e, 0xe8, 0xf5, 0x31, 0x06, 0x76,
+  0xe7, 0xa2, 0x4e, 0x47, 0x83, 0x26, 0x67, 0xd4, 0x42, 0x1b, 0xc6, 0xfd, 0x70, 0x13, 0xfd, 0xf3,
+  0xd9, 0x38, 0xa1, 0x27, 0xaa, 0x21, 0xd1, 0x6f, 0xd6, 0x83, 0x7d, 0x7e, 0x7d, 0x91, 0x1e, 0x45,
+  0xdb, 0xfd, 0x0f, 0x65, 0xdb, 0xdd, 0x3f, 0x82, 0x1f, 0x60, 0xe6, 0x3d, 0x9f, 0x31, 0xd2, 0xc5,
+  0xac, 0xa3, 0xc0, 0x2f, 0x86, 0x51, 0x80, 0xe6, 0xc5, 0x88, 0x95, 0x67, 0xe8, 0xa5, 0xd6, 0x3c,
+  0xb6, 0x39, 0x76, 0xc2, 0xac, 0x5d, 0x22, 0x93, 0xba, 0x90, 0xb1, 0x56, 0x37, 0xa4, 0x39, 0x70,
+  0xea, 0xe8, 0x1e, 0x0b, 0xe6, 0x9a, 0x77, 0x06, 0xea, 0x21, 0xb2, 0xe1, 0xb0, 0x23, 0x96, 0x56,
+  0xb5, 0x0e, 0x99, 0xbf, 0x1b, 0x2d, 0xda, 0x79, 0x0a, 0x3f, 0x41, 0x3b, 0xea, 0x1b, 0x3a, 0x73,
+  0x2f, 0xeb, 0xe5, 0xaa, 0x45, 0x6d, 0xd3, 0x54, 0x45, 0x6c, 0xed, 0xac, 0xde, 0xdd, 0x69, 0x7f,
+  0x08, 0xf3, 0xc2, 0x6c, 0x41, 0xa7, 0xd7, 0x38, 0xbe, 0x7f, 0x72, 0xc4, 0xef, 0x37, 0x56, 0xa5,
+  0x9c, 0xad, 0x4d, 0xdd, 0x61, 0xd7, 0x66, 0xeb, 0xc3, 0xae, 0xa8, 0x62, 0x59, 0xe9, 0xc2, 0x55,
+  0xf5, 0xa7, 0xcb, 0x24, 0xff, 0x64, 0x93, 0x5a, 0x67, 0x96, 0xc8, 0x3d, 0x8e, 0xcb, 0x4e, 0x15,
+  0x06, 0xc7, 0x90, 0xa6, 0xc2, 0x87, 0xae, 0x86, 0xbb, 0x2b, 0x0f, 0xab, 0xc0, 0x9f, 0xce, 0xc6,
+  0x35, 0xb7, 0xc8, 0x19, 0xef, 0xc9, 0xeb, 0x3a, 0x31, 0xba, 0x32, 0x58, 0x51, 0x28, 0xeb, 0x77,
+  0xcf, 0x14, 0xc5, 0xf9, 0xf9, 0x3d, 0xef, 0x0f, 0xec, 0x10, 0xae, 0x03, 0x35, 0x80, 0x4a, 0x85,
+  0x03, 0x1b, 0x51, 0xe9, 0xbd, 0x86, 0xf4, 0x91, 0xec, 0x8c, 0xa6, 0xf0, 0xf8, 0xe8, 0x20, 0x39,
+  0x8a, 0x60, 0xfe, 0x79, 0xf6, 0xe8, 0x5c, 0xc9, 0xca, 0xd2, 0x23, 0xc5, 0x0d, 0xfd, 0xd1, 0x9c,
+  0x31, 0x35, 0x82, 0xef, 0x5a, 0x8f, 0x60, 0xbe, 0x53, 0xdc, 0x7d, 0xed, 0xcb, 0x05, 0x8f, 0xaf,
+  0xd7, 0x7c, 0xef, 0xed, 0x9c, 0x57, 0xc9, 0x45, 0xdf, 0x41, 0x4a, 0x0f, 0xfb, 0xfa, 0x97, 0xf7,
+  0xdb, 0x3b, 0xdf, 0xf3, 0x2e, 0x88, 0xa3, 0x2d, 0xb7, 0xae, 0x5a, 0xd8, 0x50, 0x74, 0x12, 0x8a,
+  0x3e, 0x27, 0x2c, 0x88, 0x47, 0x44, 0x05, 0xf1, 0xb3, 0xac, 0x9c, 0x35, 0x7e, 0xc1, 0x24, 0xb9,
+  0x9f, 0x32, 0x4e, 0xe7, 0xc2, 0xb5, 0x13, 0xb2, 0x52, 0xf3, 0xbd, 0xdf, 0x2c, 0x19, 0x0d, 0x87,
+  0xcf, 0xf4, 0x85, 0x1f, 0x39, 0x90, 0xc6, 0xbc, 0xc8, 0x68, 0xea, 0x62, 0xa9, 0xc6, 0x33, 0x0e,
+  0x1a, 0xd0, 0x37, 0xfb, 0xad, 0xa9, 0x9e, 0x06, 0x0e, 0x1a, 0xa4, 0x07, 0xa5, 0x06, 0xab, 0xa8,
+  0xdf, 0xd3, 0xa6, 0x05, 0x06, 0xe0, 0x87, 0xb5, 0xae, 0x61, 0xd5, 0x6e, 0xc0, 0xd9, 0xe7, 0x64,
+  0xaf, 0x52, 0x8a, 0x74, 0x76, 0xd4, 0xe1, 0x8d, 0xd1, 0x49, 0x25, 0xd3, 0x0c, 0xad, 0x7a, 0xa2,
+  0x77, 0x1b, 0x7a, 0xfd, 0x53, 0xf5, 0x2f, 0x18, 0xdd, 0xd4, 0x62, 0x72, 0xc3, 0x87, 0xb2, 0xb0,
+  0xf8, 0xc0, 0x8c, 0x6e, 0xf3, 0x3d, 0xc3, 0x87, 0x04, 0xbd, 0xd6, 0x3e, 0x8a, 0x40, 0x8b, 0x72,
+  0x9c, 0xe8, 0x3e, 0x39, 0x2d, 0xc1, 0x5e, 0xf2, 0xbf, 0x4f, 0x0e, 0xa4, 0x99, 0x5c, 0xd0, 0xab,
+  0x4d, 0x05, 0x3e, 0x40, 0x4b, 0xad, 0x11, 0x11, 0x83, 0x15, 0xe1, 0x37, 0x26, 0x49, 0x3a, 0xef,
+  0x6e, 0xda, 0xec, 0x34, 0xf2, 0xd7, 0x8e, 0x48, 0x5f, 0x04, 0x1c, 0x86, 0x09, 0xcf, 0x74, 0xec,
+  0x66, 0x4d, 0xb4, 0x8e, 0x2d, 0x32, 0x59, 0xc9, 0x11, 0xb1, 0xc5, 0x93, 0x73, 0x15, 0x73, 0xbd,
+  0xc1, 0x87, 0x81, 0x20, 0xad, 0x37, 0xdb, 0x7e, 0x3d, 0x76, 0xa8, 0x56, 0x64, 0x21, 0x6b, 0xa8,
+  0x86, 0x03, 0xdf, 0x69, 0xc4, 0x85, 0x2e, 0xbc, 0xab, 0x87, 0x09, 0x61, 0x90, 0x0c, 0x48, 0x33,
+  0x7d, 0x92, 0x3d, 0xd0, 0x3d, 0x73, 0x53, 0x9d, 0x70, 0x93, 0x34, 0x87, 0x7c, 0x73, 0xb1, 0xc6,
+  0xfd, 0xf8, 0x8b, 0xf9, 0xe5, 0x40, 0xf7, 0x9e, 0x9a, 0x04, 0x29, 0x91, 0xe7, 0xbe, 0x94, 0xae,
+  0x28, 0x08, 0x76, 0xa4, 0x8f, 0x84, 0x5a, 0x4f, 0xe0, 0x67, 0x43, 0x0a, 0x4b, 0x8c, 0xae, 0xe6,
+  0x41, 0x70, 0x9e, 0x45, 0x4a, 0x7f, 0x56, 0x39, 0x38, 0x43, 0xe4, 0xca, 0xad, 0x4e, 0x59, 0x4c,
+  0x69, 0xdd, 0x2a, 0x9a, 0x6f, 0x26, 0xcd, 0xc4, 0xda, 0x40, 0x5f, 0x4c, 0x3c, 0xcf, 0xfa, 0xd1,
+  0x01, 0x1d, 0xef, 0x8a, 0x66, 0x89, 0x44, 0x42, 0xa7, 0x17, 0x3a, 0xbe, 0x65, 0xb5, 0x78, 0xe3,
+  0xc8, 0xa1, 0x7d, 0x01, 0xcf, 0x82, 0xc6, 0xad, 0xba, 0xcb, 0x5f, 0xcf, 0xda, 0x31, 0x0e, 0x74,
+  0x77, 0x67, 0xcf, 0x97, 0x1b, 0x75, 0xba, 0xbf, 0x00, 0x82, 0xc0, 0x62, 0x84, 0x4b, 0xde, 0x57,
+  0xf9, 0x1d, 0xeb, 0xb2, 0x4c, 0x19, 0x69, 0x34, 0x1e, 0xc0, 0x91, 0x53, 0xa3, 0xda, 0xa7, 0xd0,
+  0xaf, 0xd2, 0x22, 0x89, 0xd4, 0x53, 0x16, 0x3e, 0x02, 0xab, 0x62, 0xb0, 0x5b, 0x1b, 0xcf, 0x64,
+  0xa3, 0xcc, 0xda, 0xdc, 0x94, 0xeb, 0xd5, 0x2e, 0x96, 0xe6, 0x14, 0xff, 0x81, 0xce, 0x47, 0x72,
+  0xcf, 0x01, 0x28, 0xfe, 0x59, 0xe5, 0x06, 0x1d, 0x75, 0x13, 0xb9, 0x9f, 0xfb, 0xa1, 0x4f, 0xb9,
+  0x47, 0x9f, 0x1d, 0x10, 0xa6, 0x72, 0x60, 0xb6, 0xd7, 0xd4, 0xf3, 0xc1, 0x65, 0x0a, 0xee, 0x56,
+  0x7b, 0xec, 0x42, 0xc0, 0x0c, 0x02, 0x81, 0xa8, 0x21, 0x04, 0x2a, 0x5b, 0x54, 0xbf, 0x18, 0xfc,
+  0x78, 0xda, 0xec, 0x88, 0x39, 0xf0, 0xe3, 0xef, 0x52, 0x24, 0x08, 0x3b, 0xb6, 0x20, 0xb1, 0x01,
+  0x67, 0x19, 0xf9, 0xd3, 0xd0, 0x59, 0x5a, 0x58, 0xc5, 0x5f, 0x26, 0xd8, 0x2a, 0xea, 0x04, 0x6d,
+  0xcf, 0xc1, 0xa8, 0xc7, 0x0f, 0xdb, 0x33, 0x5d, 0x9f, 0xda, 0xba, 0x74, 0x75, 0xe1, 0x6f, 0xdd,
+  0xf1, 0x17, 0x51, 0xd7, 0xdc, 0xf7, 0x31, 0x6b, 0x7b, 0x4f, 0xca, 0x76, 0x88, 0x8c, 0x44, 0x6a,
+  0xf6, 0x6d, 0x44, 0x26, 0xb3, 0x65, 0xa7, 0x1c, 0x35, 0x72, 0x0b, 0x86, 0x62, 0xc0, 0xd2, 0xf5,
+  0xbf, 0x90, 0x70, 0x0a, 0x89, 0x41, 0xae, 0xdd, 0xf4, 0xe1, 0x16, 0xf1, 0x0a, 0x17, 0x0d, 0xea,
+  0xaf, 0x48, 0xe3, 0x17, 0x27, 0xc0, 0x9d, 0x2a, 0x4b, 0x07, 0x38, 0x25, 0x54, 0xfc, 0x4d, 0xa5,
+  0x4f, 0xa9, 0x7d, 0x61, 0x0b, 0xe2, 0x5e, 0x23, 0xb5, 0x17, 0x12, 0x6d, 0x47, 0xba, 0x5b, 0xbb,
+  0xba, 0xcd, 0x06, 0xf1, 0x12, 0x2d, 0x5d, 0x72, 0x4a, 0xa9, 0x06, 0xf3, 0x25, 0x31, 0xb9, 0xd7,
+  0x7a, 0xad, 0xa9, 0xf4, 0x01, 0xb5, 0x0c, 0xe3, 0x1d, 0xb5, 0xf4, 0xb5, 0xf3, 0x7a, 0x2f, 0xc2,
+  0xfe, 0x5c, 0x29, 0xfa, 0xd2, 0x1f, 0xda, 0xba, 0xb1, 0xf0, 0x6c, 0xab, 0xbf, 0xc6, 0xee, 0x8a,
+  0x01, 0x56, 0x73, 0xc4, 0x2d, 0xe9, 0x89, 0x4a, 0xf2, 0xf9, 0x13, 0xf5, 0x94, 0x5b, 0x61, 0x85,
+  0x7f, 0x7b, 0xb0, 0xf5, 0x6b, 0xa6, 0xbd, 0x78, 0xc0, 0x53, 0xc7, 0x8a, 0xd0, 0xd6, 0xd6, 0xc3,
+  0x83, 0x2c, 0x2f, 0x06, 0x94, 0xa6, 0x33, 0x8c, 0xcf, 0x52, 0x6a, 0xf9, 0x94, 0xa2, 0x15, 0x19,
+  0x4f, 0xbc, 0x79, 0xe7, 0xe0, 0xb4, 0x76, 0x4b, 0xdf, 0xe2, 0x81, 0xde, 0x5f, 0x11, 0x08, 0xad,
+  0xba, 0x23, 0xce, 0x3f, 0x55, 0x15, 0x54, 0xf7, 0x65, 0x1c, 0x55, 0x56, 0xfc, 0x03, 0x79, 0xa1,
+  0xad, 0x72, 0x67, 0x8a, 0x6d, 0x80, 0x1d, 0xf7, 0xde, 0xb7, 0x53, 0xc1, 0xdd, 0xaf, 0x99, 0x1a,
+  0xa7, 0xfc, 0xe4, 0xbb, 0xb6, 0xb6, 0xb6, 0xd2, 0x4f, 0xb7, 0xe9, 0xd6, 0x4a, 0x52, 0x49, 0x89,
+  0xfd, 0x5d, 0x44, 0x26, 0xa1, 0x10, 0x73, 0x17, 0x30, 0x95, 0x88, 0x8d, 0xfd, 0x9d, 0x51, 0x15,
+  0xf2, 0x71, 0xc3, 0xbf, 0x64, 0x78, 0xb6, 0xe4, 0x58, 0x68, 0x72, 0x79, 0x8c, 0x6b, 0x03, 0xfc,
+  0xce, 0xe3, 0xe4, 0xc8, 0x31, 0xfa, 0x94, 0x98, 0x93, 0xc1, 0x30, 0xca, 0xa0, 0xf1, 0x7d, 0x8e,
+  0x71, 0x7e, 0x94, 0x7d, 0x52, 0x5b, 0x42, 0xb3, 0xd9, 0xd9, 0x42, 0x5f, 0xf8, 0xa1, 0x24, 0x05,
+  0x85, 0xaf, 0xb6, 0x3e, 0x95, 0x04, 0x52, 0xba, 0x0c, 0xe0, 0x60, 0x2e, 0xf4, 0x5f, 0x43, 0xfa,
+  0x69, 0x05, 0xa2, 0x3e, 0x6b, 0x80, 0xfd, 0x1b, 0x4b, 0x8c, 0x36, 0x7b, 0x0b, 0x63, 0xc8, 0xd0,
+  0x58, 0x91, 0x7d, 0xcc, 0x80, 0x66, 0x6c, 0x5a, 0x45, 0xb6, 0xb4, 0x1f, 0xf6, 0x53, 0x6e, 0xc8,
+  0x52, 0xd6, 0x10, 0x31, 0xeb, 0x69, 0xa8, 0x4c, 0x70, 0x9a, 0xca, 0x49, 0x9b, 0x2f, 0xf1, 0x5f,
+  0x0b, 0xec, 0x22, 0x46, 0xa0, 0xda, 0x50, 0xaf, 0xf4, 0x83, 0xca, 0x96, 0x3f, 0xb9, 0x5b, 0x2a,
+  0x9b, 0xfe, 0xd5, 0xa3, 0x1f, 0x41, 0x54, 0xd4, 0x7c, 0x6b, 0xa3, 0xa5, 0x37, 0x3b, 0xbf, 0xe5,
+  0x25, 0xc5, 0x7d, 0x8d, 0x6b, 0x3b, 0x7f, 0x0d, 0x17, 0xf4, 0x5d, 0xcc, 0xb6, 0x3a, 0xd1, 0x11,
+  0x66, 0xb2, 0xbd, 0x1d, 0x44, 0x70, 0x7d, 0x5b, 0x9f, 0x23, 0xd2, 0xba, 0x7c, 0xdc, 0xde, 0x88,
+  0xdd, 0xf8, 0x44, 0x15, 0xfd, 0x70, 0xf3, 0x50, 0xc1, 0xe7, 0xb7, 0xc6, 0x19, 0xc8, 0x8e, 0xc0,
+  0x9c, 0x3b, 0x1a, 0xcd, 0x5b, 0xb5, 0xfc, 0x93, 0xa3, 0xfa, 0xe7, 0xfc, 0x47, 0x57, 0x90, 0x4e,
+  0x19, 0xcf, 0x7f, 0x50, 0x12, 0x8f, 0x8a, 0xcd, 0xa7, 0xb2, 0x3f, 0x7c, 0xed, 0x33, 0xd8, 0xf4,
+  0x3d, 0x17, 0x73, 0xa7, 0xf4, 0xbf, 0x79, 0x76, 0x30, 0x87, 0xf3, 0xe6, 0xfe, 0x05, 0x4b, 0xf3,
+  0x36, 0x3b, 0x16, 0x0e, 0x00, 0x00,
+};
+
+// lock.png: 214 bytes source, 214 bytes stored
+static const uint8_t lock_png[] PROGMEM = {
+  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+  0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x20, 0x08, 0x03, 0x00, 0x00, 0x00, 0x44, 0xa4, 0x8a,
+  0xc6, 0x00, 0x00, 0x00, 0x2d, 0x50, 0x4c, 0x54, 0x45, 0xff, 0xff, 0xff, 0x04, 0x07, 0x07, 0xc1,
+  0xc2, 0xc2, 0xf0, 0xf0, 0xf0, 0x33, 0x36, 0x36, 0x82, 0x83, 0x83, 0x53, 0x55, 0x55, 0x23, 0x26,
+  0x26, 0x43, 0x45, 0x45, 0x14, 0x17, 0x17, 0x62, 0x64, 0x64, 0xa1, 0xa3, 0xa3, 0x92, 0x93, 0x93,
+  0xe0, 0xe1, 0xe1, 0x72, 0x74, 0x74, 0xc2, 0x8d, 0xa7, 0xf7, 0x00, 0x00, 0x00, 0x64, 0x49, 0x44,
+  0x41, 0x54, 0x38, 0x8d, 0xed, 0x8d, 0x4b, 0x0e, 0xc0, 0x20, 0x08, 0x44, 0x05, 0xa9, 0x8a, 0x9f,
+  0xde, 0xff, 0xb8, 0xc5, 0xc4, 0x18, 0x1b, 0xe8, 0xce, 0x45, 0x9b, 0xf4, 0x2d, 0x99, 0xc7, 0x8c,
+  0x73, 0x5b, 0x29, 0x01, 0x84, 0x50, 0x1e, 0x62, 0x9f, 0x60, 0x90, 0xbc, 0x99, 0x13, 0x4c, 0xc8,
+  0x32, 0x7a, 0x3d, 0x9f, 0x88, 0x35, 0xf6, 0x19, 0x9d, 0x63, 0x7f, 0x6c, 0x73, 0x0a, 0x95, 0x90,
+  0xe5, 0xda, 0xc6, 0x98, 0x74, 0x64, 0x25, 0xd0, 0x72, 0xac, 0x52, 0xa6, 0x04, 0x29, 0x38, 0xd6,
+  0xb9, 0xf7, 0x09, 0x11, 0x0c, 0xe2, 0xfd, 0xdd, 0xe0, 0x17, 0xbe, 0x29, 0xb0, 0x95, 0xb3, 0xdb,
+  0xc3, 0x05, 0x40, 0x7a, 0x02, 0xd2, 0xd4, 0x71, 0x9f, 0x64, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+  0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+#define STATIC_ASSET_ENTRIES \
+  { "/logo.jpg", "image/jpeg", "\"28c85cdc027dd02f\"", logo_jpg, sizeof(logo_jpg), true }, \
+  { "/lock.png", "image/png", "\"aa8316986bb3573e\"", lock_png, sizeof(lock_png), false },
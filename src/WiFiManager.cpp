@@ -11,12 +11,150 @@
  **************************************************************/
 
 #include "WiFiManager.h"
+#include "StaticAssets.h"
+#include <coredecls.h>
+#include <algorithm>
+
+#define WM_FAST_CONNECT_MAGIC 0x57464331 // "WFC1"
+
+// what a fast reconnect needs, kept in RTC memory by storeFastConnect()
+struct WiFiFastConnect {
+  uint32_t magic;
+  uint32_t credentials;   // crc of ssid and password, the cache is only used for the credentials it was made with
+  uint8_t  bssid[6];
+  uint8_t  channel;
+  uint8_t  reuses;        // fast reconnects on this lease since DHCP handed it out
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+  uint32_t crc;
+};
+
+// RTC user memory is 128 blocks of 4 bytes
+static_assert(WM_FAST_CONNECT_RTC_OFFSET + sizeof(WiFiFastConnect) / 4 <= 128, "fast reconnect cache does not fit in RTC user memory");
+
+// Portal pages are streamed to the client in chunks through a fixed stack buffer, so the heap
+// used by a page does not depend on the number of networks or parameters on it
+class WiFiManagerPage {
+  public:
+    WiFiManagerPage(ESP8266WebServer& server) : _server(server) {
+      _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+      _server.send(200, "text/html", "");
+    }
+
+    void print(const char* text) {
+      write(text, strlen(text), false);
+    }
+
+    void print_P(PGM_P text) {
+      write(text, strlen_P(text), true);
+    }
+
+    // fill a PROGMEM template: {k} for every character k in keys is replaced by the matching value,
+    // html escaped. {c} is custom html and inserted as it is
+    void printTemplate(PGM_P text, const char* keys, const char* const values[]) {
+      PGM_P start = text;
+      for (PGM_P p = text; ; p++) {
+        char c = pgm_read_byte(p);
+        if (c == 0) {
+          write(start, p - start, true);
+          return;
+        }
+        if (c != '{') {
+          continue;
+        }
+        char name = pgm_read_byte(p + 1);
+        const char* key = name != 0 ? strchr(keys, name) : NULL;
+        if (key == NULL || pgm_read_byte(p + 2) != '}') {
+          continue;
+        }
+        write(start, p - start, true);
+        const char* value = values[key - keys];
+        if (*key == 'c') {
+          print(value);
+        } else {
+          printEscaped(value);
+        }
+        p += 2;
+        start = p + 1;
+      }
+    }
+
+    // close the page and send the terminating chunk
+    void end() {
+      print_P(HTTP_END);
+      if (_used > 0) {
+        _server.sendContent(_buffer, _used);
+      }
+      _server.sendContent("");
+    }
+
+  private:
+    ESP8266WebServer& _server;
+    char              _buffer[WM_PAGE_CHUNK_SIZE];
+    size_t            _used = 0;
+
+    void write(const char* data, size_t length, boolean progmem) {
+      while (length > 0) {
+        if (_used == sizeof(_buffer)) {
+          _server.sendContent(_buffer, _used);
+          _used = 0;
+        }
+        size_t n = std::min(length, sizeof(_buffer) - _used);
+        if (progmem) {
+          memcpy_P(_buffer + _used, data, n);
+        } else {
+          memcpy(_buffer + _used, data, n);
+        }
+        _used += n;
+        data += n;
+        length -= n;
+      }
+    }
+
+    // network names and parameter values can contain anything
+    void printEscaped(const char* text) {
+      const char* start = text;
+      for (; *text; text++) {
+        const char* entity;
+        switch (*text) {
+          case '&':  entity = "&amp;";  break;
+          case '<':  entity = "&lt;";   break;
+          case '>':  entity = "&gt;";   break;
+          case '\'': entity = "&#39;";  break;
+          case '"':  entity = "&quot;"; break;
+          default:   continue;
+        }
+        write(start, text - start, false);
+        print(entity);
+        start = text + 1;
+      }
+      write(start, text - start, false);
+    }
+};
+
+static void formatIp(char* buffer, size_t size, const IPAddress& ip) {
+  snprintf(buffer, size, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+}
+
+static void formatMac(char* buffer, size_t size, const uint8_t* mac) {
+  snprintf(buffer, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+static uint32_t credentialsCrc() {
+  struct station_config conf;
+  wifi_station_get_config(&conf);
+  return crc32(conf.password, strnlen((char*)conf.password, sizeof(conf.password)),
+               crc32(conf.ssid, strnlen((char*)conf.ssid, sizeof(conf.ssid))));
+}
 
 WiFiManagerParameter::WiFiManagerParameter(const char *custom) {
   _id = NULL;
   _placeholder = NULL;
   _length = 0;
   _value = NULL;
+  _truncated = false;
 
   _customHTML = custom;
 }
@@ -34,9 +172,10 @@ void WiFiManagerParameter::init(const char *id, const char *placeholder, const c
   _placeholder = placeholder;
   _length = length;
   _value = new char[length + 1];
-  for (int i = 0; i < length; i++) {
+  for (int i = 0; i < length + 1; i++) {
     _value[i] = 0;
   }
+  _truncated = false;
   if (defaultValue != NULL) {
     strncpy(_value, defaultValue, length);
   }
@@ -44,6 +183,10 @@ void WiFiManagerParameter::init(const char *id, const char *placeholder, const c
   _customHTML = custom;
 }
 
+WiFiManagerParameter::~WiFiManagerParameter() {
+  delete[] _value;
+}
+
 const char* WiFiManagerParameter::getValue() {
   return _value;
 }
@@ -59,6 +202,9 @@ int WiFiManagerParameter::getValueLength() {
 const char* WiFiManagerParameter::getCustomHTML() {
   return _customHTML;
 }
+bool WiFiManagerParameter::isValueTruncated() {
+  return _truncated;
+}
 
 WiFiManager::WiFiManager() {
 }
@@ -117,10 +263,14 @@ void WiFiManager::setupConfigPortal() {
   server->on("/r", std::bind(&WiFiManager::handleReset, this));
   //server->on("/generate_204", std::bind(&WiFiManager::handle204, this));  //Android/Chrome OS captive portal check.
   server->on("/fwlink", std::bind(&WiFiManager::handleRoot, this));  //Microsoft captive portal. Maybe not needed. Might be handled by notFound handler.
+  registerStaticAssets(*server);
   server->onNotFound (std::bind(&WiFiManager::handleNotFound, this));
   server->begin(); // Web server start
   DEBUG_WM(F("HTTP server started"));
 
+  // the network list is usually the first thing asked for, have it ready
+  startScan();
+
 }
 
 boolean WiFiManager::autoConnect() {
@@ -138,6 +288,7 @@ boolean WiFiManager::autoConnect(char const *apName, char const *apPassword) {
 
   // attempt to connect; should it fail, fall back to AP
   WiFi.mode(WIFI_STA);
+  wifi_station_ap_number_set(WM_MAX_CREDENTIALS);
 
   if (connectWifi("", "") == WL_CONNECTED)   {
     DEBUG_WM(F("IP Address:"));
@@ -170,7 +321,7 @@ boolean  WiFiManager::startConfigPortal(char const *apName, char const *apPasswo
     dnsServer->processNextRequest();
     //HTTP
     server->handleClient();
-
+    updateScan();
 
     if (connect) {
       connect = false;
@@ -206,6 +357,9 @@ boolean  WiFiManager::startConfigPortal(char const *apName, char const *apPasswo
 
   server.reset();
   dnsServer.reset();
+  _scanResults.reset();
+  _scanCount = 0;
+  _scanDone = false;
 
   return  WiFi.status() == WL_CONNECTED;
 }
@@ -230,13 +384,19 @@ int WiFiManager::connectWifi(String ssid, String pass) {
     WiFi.begin(ssid.c_str(), pass.c_str());
   } else {
     if (WiFi.SSID()) {
-      DEBUG_WM("Using last saved values, should be faster");
       //trying to fix connection in progress hanging
       ETS_UART_INTR_DISABLE();
       wifi_station_disconnect();
       ETS_UART_INTR_ENABLE();
 
-      WiFi.begin();
+      if (fastConnect()) {
+        return WL_CONNECTED;
+      }
+
+      if (!connectStrongest()) {
+        DEBUG_WM("Using last saved values, should be faster");
+        WiFi.begin();
+      }
     } else {
       DEBUG_WM("No saved credentials");
     }
@@ -251,9 +411,258 @@ int WiFiManager::connectWifi(String ssid, String pass) {
     //should be connected at the end of WPS
     connRes = waitForConnectResult();
   }
+  if (connRes == WL_CONNECTED) {
+    storeFastConnect();
+  }
   return connRes;
 }
 
+// connect to the cached access point on its channel with the cached ip settings, no scan and no DHCP.
+// Falls back (returns false) when there is no cache or the access point does not answer in time
+boolean WiFiManager::fastConnect() {
+  if (!_fastConnect || _sta_static_ip) {
+    return false;
+  }
+  WiFiFastConnect cache;
+  ESP.rtcUserMemoryRead(WM_FAST_CONNECT_RTC_OFFSET, (uint32_t*)&cache, sizeof(cache));
+  if (cache.magic != WM_FAST_CONNECT_MAGIC || cache.crc != crc32(&cache, offsetof(WiFiFastConnect, crc))
+      || cache.credentials != credentialsCrc()) {
+    DEBUG_WM(F("No fast reconnect data"));
+    return false;
+  }
+  if (cache.reuses >= WM_FAST_CONNECT_MAX_REUSES) {
+    DEBUG_WM(F("Cached lease used up, doing a full connect"));
+    clearFastConnect();
+    return false;
+  }
+
+  DEBUG_WM(F("Fast reconnect to the last access point"));
+  unsigned long start = millis();
+  WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+
+  // lock onto the access point in the current config only, the saved config stays as it is
+  struct station_config conf;
+  wifi_station_get_config(&conf);
+  conf.bssid_set = 1;
+  memcpy(conf.bssid, cache.bssid, sizeof(conf.bssid));
+  ETS_UART_INTR_DISABLE();
+  wifi_station_set_config_current(&conf);
+  wifi_set_channel(cache.channel);
+  wifi_station_connect();
+  ETS_UART_INTR_ENABLE();
+
+  while (WiFi.status() != WL_CONNECTED && millis() - start < WM_FAST_CONNECT_TIMEOUT) {
+    delay(10);
+  }
+  if (WiFi.status() == WL_CONNECTED) {
+    DEBUG_WM(String(F("Fast reconnect took ")) + (millis() - start) + F(" ms"));
+    _apLocked = true;
+    _apLockSeen = millis();
+    cache.reuses++;
+    cache.crc = crc32(&cache, offsetof(WiFiFastConnect, crc));
+    ESP.rtcUserMemoryWrite(WM_FAST_CONNECT_RTC_OFFSET, (uint32_t*)&cache, sizeof(cache));
+    // serviceLease() hands the address back to DHCP after WM_FAST_CONNECT_DHCP_DELAY
+    _staticLease = true;
+    _staticLeaseSince = millis();
+    _gotIpHandler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP& event) {
+      if (!_staticLease) {
+        _leaseBound = true;
+      }
+    });
+    return true;
+  }
+
+  // the access point moved or the lease is gone, start over with scan and DHCP
+  DEBUG_WM(F("Fast reconnect failed, doing a full connect"));
+  clearFastConnect();
+  ETS_UART_INTR_DISABLE();
+  wifi_station_disconnect();
+  conf.bssid_set = 0;
+  wifi_station_set_config_current(&conf);
+  ETS_UART_INTR_ENABLE();
+  WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));   // back to DHCP
+  return false;
+}
+
+// with more than one known network, scan once and connect to the strongest access point of any of them.
+// Returns false when there is nothing to choose from, the caller then connects to the last network as before
+boolean WiFiManager::connectStrongest() {
+  struct station_config known[WM_SDK_AP_SLOTS];
+  uint8_t count = wifi_station_get_ap_info(known);
+  if (count < 2) {
+    return false;
+  }
+
+  DEBUG_WM(F("Looking for the strongest known access point"));
+  int n = WiFi.scanNetworks();
+  int best = -1;
+  uint8_t bestKnown = 0;
+  for (int i = 0; i < n; i++) {
+    for (uint8_t k = 0; k < count; k++) {
+      if (strncmp(WiFi.SSID(i).c_str(), (char*)known[k].ssid, sizeof(known[k].ssid)) == 0
+          && (best == -1 || WiFi.RSSI(i) > WiFi.RSSI(best))) {
+        best = i;
+        bestKnown = k;
+      }
+    }
+  }
+  if (best == -1) {
+    WiFi.scanDelete();
+    DEBUG_WM(F("No known network in range"));
+    return false;
+  }
+
+  DEBUG_WM(String(F("Connecting to ")) + WiFi.SSID(best) + F(" ") + WiFi.BSSIDstr(best) + F(" ") + WiFi.RSSI(best) + F(" dBm"));
+  lockAccessPoint(known[bestKnown], WiFi.BSSID(best), WiFi.channel(best));
+  WiFi.scanDelete();
+  return true;
+}
+
+// connect to one access point of a known network. Only the current config is changed,
+// the saved credentials stay as they are
+void WiFiManager::lockAccessPoint(const struct station_config& credentials, const uint8_t* bssid, uint8_t channel) {
+  struct station_config conf = credentials;
+  conf.bssid_set = 1;
+  memcpy(conf.bssid, bssid, sizeof(conf.bssid));
+  ETS_UART_INTR_DISABLE();
+  wifi_station_disconnect();
+  wifi_station_set_config_current(&conf);
+  wifi_set_channel(channel);
+  wifi_station_connect();
+  ETS_UART_INTR_ENABLE();
+  _apLocked = true;
+  _apLockNew = true;
+  _apLockSeen = millis();
+}
+
+// let the SDK pick any access point of the network again, used when the locked one is gone
+void WiFiManager::unlockAccessPoint() {
+  struct station_config conf;
+  wifi_station_get_config(&conf);
+  conf.bssid_set = 0;
+  ETS_UART_INTR_DISABLE();
+  wifi_station_disconnect();
+  wifi_station_set_config_current(&conf);
+  wifi_station_connect();
+  ETS_UART_INTR_ENABLE();
+  _apLocked = false;
+  _apLockNew = false;
+}
+
+void WiFiManager::roam() {
+  serviceLease();
+  if (WiFi.getMode() != WIFI_STA) {
+    return;
+  }
+
+  if (WiFi.status() != WL_CONNECTED) {
+    // a locked access point that does not come back would keep the station offline
+    if (_apLocked && millis() - _apLockSeen > WM_ROAM_CONNECT_TIMEOUT) {
+      DEBUG_WM(F("Access point lost, releasing the lock"));
+      unlockAccessPoint();
+    }
+    return;
+  }
+  _apLockSeen = millis();
+  if (_apLockNew) {
+    // connected through the new lock, remember it for the next fast reconnect
+    _apLockNew = false;
+    storeFastConnect();
+  }
+
+  if (_roamScanning) {
+    int n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING) {
+      return;
+    }
+    _roamScanning = false;
+    if (n < 0) {
+      return;
+    }
+    // strongest access point of the current network other than the current one
+    struct station_config current;
+    wifi_station_get_config(&current);
+    int best = -1;
+    for (int i = 0; i < n; i++) {
+      if (strncmp(WiFi.SSID(i).c_str(), (char*)current.ssid, sizeof(current.ssid)) == 0
+          && memcmp(WiFi.BSSID(i), WiFi.BSSID(), 6) != 0
+          && (best == -1 || WiFi.RSSI(i) > WiFi.RSSI(best))) {
+        best = i;
+      }
+    }
+    if (best != -1 && WiFi.RSSI(best) >= WiFi.RSSI() + WM_ROAM_HYSTERESIS) {
+      DEBUG_WM(String(F("Roaming to ")) + WiFi.BSSIDstr(best) + F(" ") + WiFi.RSSI(best) + F(" dBm, was ") + WiFi.RSSI() + F(" dBm"));
+      lockAccessPoint(current, WiFi.BSSID(best), WiFi.channel(best));
+    }
+    WiFi.scanDelete();
+    return;
+  }
+
+  if (millis() - _roamCheck < WM_ROAM_CHECK_INTERVAL) {
+    return;
+  }
+  _roamCheck = millis();
+  if (WiFi.RSSI() >= WM_ROAM_RSSI_THRESHOLD) {
+    _roamWeakSamples = 0;
+    return;
+  }
+  if (++_roamWeakSamples < WM_ROAM_WEAK_SAMPLES || (_roamScan != 0 && millis() - _roamScan < WM_ROAM_MIN_INTERVAL)) {
+    return;
+  }
+  DEBUG_WM(F("Weak signal, looking for a better access point"));
+  _roamWeakSamples = 0;
+  _roamScan = millis();
+  _roamScanning = WiFi.scanNetworks(true) == WIFI_SCAN_RUNNING;
+}
+
+// after a fast reconnect, hand the cached address back to DHCP, which confirms or replaces it and renews
+// the lease from then on. Every address DHCP binds afterwards is cached for the next fast reconnect
+void WiFiManager::serviceLease() {
+  if (WiFi.status() != WL_CONNECTED) {
+    return;
+  }
+  if (_staticLease && millis() - _staticLeaseSince >= WM_FAST_CONNECT_DHCP_DELAY) {
+    DEBUG_WM(F("Restarting DHCP after the fast reconnect"));
+    _staticLease = false;
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+  }
+  if (_leaseBound) {
+    _leaseBound = false;
+    storeFastConnect();
+  }
+}
+
+void WiFiManager::storeFastConnect() {
+  if (!_fastConnect || WiFi.status() != WL_CONNECTED) {
+    return;
+  }
+  WiFiFastConnect cache;
+  if (_staticLease) {
+    // still on the cached lease, only the access point changed. The address is not a new lease, the reuses stay
+    ESP.rtcUserMemoryRead(WM_FAST_CONNECT_RTC_OFFSET, (uint32_t*)&cache, sizeof(cache));
+    if (cache.magic != WM_FAST_CONNECT_MAGIC) {
+      return;
+    }
+  } else {
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = WM_FAST_CONNECT_MAGIC;
+    cache.credentials = credentialsCrc();
+    cache.ip = (uint32_t)WiFi.localIP();
+    cache.gateway = (uint32_t)WiFi.gatewayIP();
+    cache.subnet = (uint32_t)WiFi.subnetMask();
+    cache.dns = (uint32_t)WiFi.dnsIP();
+  }
+  memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+  cache.channel = WiFi.channel();
+  cache.crc = crc32(&cache, offsetof(WiFiFastConnect, crc));
+  ESP.rtcUserMemoryWrite(WM_FAST_CONNECT_RTC_OFFSET, (uint32_t*)&cache, sizeof(cache));
+}
+
+void WiFiManager::clearFastConnect() {
+  uint32_t magic = 0;
+  ESP.rtcUserMemoryWrite(WM_FAST_CONNECT_RTC_OFFSET, &magic, sizeof(magic));
+}
+
 uint8_t WiFiManager::waitForConnectResult() {
   if (_connectTimeout == 0) {
     return WiFi.waitForConnectResult();
@@ -264,19 +673,99 @@ uint8_t WiFiManager::waitForConnectResult() {
     uint8_t status;
     while (keepConnecting) {
       status = WiFi.status();
-      if (millis() > start + _connectTimeout) {
+      if (millis() - start > _connectTimeout) {
         keepConnecting = false;
         DEBUG_WM (F("Connection timed out"));
       }
       if (status == WL_CONNECTED || status == WL_CONNECT_FAILED) {
         keepConnecting = false;
+      } else {
+        delay(10);
       }
-      delay(100);
     }
+    DEBUG_WM (String(F("Connection result ")) + status + F(" after ") + (millis() - start) + F(" ms"));
     return status;
   }
 }
 
+// start a background scan unless one is running, results are picked up by updateScan()
+void WiFiManager::startScan() {
+  if (WiFi.scanComplete() == WIFI_SCAN_RUNNING) {
+    return;
+  }
+  DEBUG_WM(F("Starting network scan"));
+  WiFi.scanNetworks(true);
+}
+
+void WiFiManager::updateScan() {
+  int n = WiFi.scanComplete();
+  if (n < 0) {
+    return;  // running, or no scan started
+  }
+  DEBUG_WM(F("Scan done"));
+  collectScan(n);
+  WiFi.scanDelete();
+}
+
+// FNV-1a, only used to find duplicate network names
+static uint32_t ssidHash(const char* ssid) {
+  uint32_t hash = 2166136261u;
+  while (*ssid) {
+    hash = (hash ^ (uint8_t)*ssid++) * 16777619u;
+  }
+  return hash;
+}
+
+// copy the scan results into the compact cache once: sorted by signal strength,
+// and without duplicates, keeping the strongest access point of every name
+void WiFiManager::collectScan(int n) {
+  std::unique_ptr<WiFiScanEntry[]> results(new WiFiScanEntry[n > 0 ? n : 1]);
+  for (int i = 0; i < n; i++) {
+    strlcpy(results[i].ssid, WiFi.SSID(i).c_str(), sizeof(results[i].ssid));
+    results[i].rssi = WiFi.RSSI(i);
+    results[i].encrypted = WiFi.encryptionType(i) != ENC_TYPE_NONE;
+  }
+  std::sort(results.get(), results.get() + n, [](const WiFiScanEntry & a, const WiFiScanEntry & b) {
+    return a.rssi > b.rssi;
+  });
+
+  int count = n;
+  if (_removeDuplicateAPs && n > 1) {
+    // open addressing table of kept entries (index + 1), at most half full
+    int size = 4;
+    while (size < 2 * n) {
+      size <<= 1;
+    }
+    std::unique_ptr<uint8_t[]> seen(new uint8_t[size]());
+    count = 0;
+    for (int i = 0; i < n && i < 255; i++) {
+      int slot = ssidHash(results[i].ssid) & (size - 1);
+      boolean duplicate = false;
+      while (seen[slot] != 0) {
+        if (strcmp(results[seen[slot] - 1].ssid, results[i].ssid) == 0) {
+          duplicate = true;
+          break;
+        }
+        slot = (slot + 1) & (size - 1);
+      }
+      if (duplicate) {
+        DEBUG_WM(String(F("DUP AP: ")) + results[i].ssid);
+        continue;
+      }
+      if (count != i) {
+        results[count] = results[i];
+      }
+      count++;
+      seen[slot] = count;
+    }
+  }
+
+  _scanResults = std::move(results);
+  _scanCount = count;
+  _scanTime = millis();
+  _scanDone = true;
+}
+
 void WiFiManager::startWPS() {
   DEBUG_WM("START WPS");
   WiFi.beginWPSConfig();
@@ -310,7 +799,23 @@ String WiFiManager::getConfigPortalSSID() {
 void WiFiManager::resetSettings() {
   DEBUG_WM(F("settings invalidated"));
   DEBUG_WM(F("THIS MAY CAUSE AP NOT TO START UP PROPERLY. YOU NEED TO COMMENT IT OUT AFTER ERASING THE DATA."));
+  clearFastConnect();
   WiFi.disconnect(true);
+
+  // disconnect(true) only blanks the current slot of the SDK access point store, connectStrongest
+  // would still find the other networks there. Blank every slot the SDK has, not only ours
+  struct station_config empty;
+  memset(&empty, 0, sizeof(empty));
+  ETS_UART_INTR_DISABLE();
+  wifi_station_ap_number_set(WM_SDK_AP_SLOTS);
+  for (uint8_t i = 0; i < WM_SDK_AP_SLOTS; i++) {
+    if (wifi_station_ap_change(i)) {
+      wifi_station_set_config(&empty);
+    }
+  }
+  wifi_station_ap_change(0);
+  wifi_station_ap_number_set(WM_MAX_CREDENTIALS);
+  ETS_UART_INTR_ENABLE();
   //delay(200);
 }
 void WiFiManager::setTimeout(unsigned long seconds) {
@@ -356,173 +861,93 @@ void WiFiManager::handleRoot() {
     return;
   }
 
-  String page = FPSTR(HTTP_HEADER);
-  page.replace("{v}", "Options");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += "<img style=\"display: block;  margin-left: auto; margin-right: auto; margin-botom: 5px;  width: 70%;\" src=\"data:image/jpeg;base64,/9j/4AAQSkZJRgABAQEASABIAAD/4QBmRXhpZgAATU0AKgAAAAgABAEaAAUAAAABAAAAPgEbAAUAAAABAAAARgEoAAMAAAABAAIAAAExAAIAAAAQAAAATgAAAAAAAABIAAAAAQAAAEgAAAABcGFpbnQubmV0IDQuMy4xAP/hHU1odHRwOi8vbnMuYWRvYmUuY29tL3hhcC8xLjAvADw/eHBhY2tldCBiZWdpbj0i77u/IiBpZD0iVzVNME1wQ2VoaUh6cmVTek5UY3prYzlkIj8+DQo8eDp4bXBtZXRhIHhtbG5zOng9ImFkb2JlOm5zOm1ldGEvIiB4OnhtcHRrPSJBZG9iZSBYTVAgQ29yZSA1LjYtYzAxMSA3OS4xNTYyODksIDIwMTQvMDMvMzEtMjM6Mzk6MTIgICAgICAgICI+DQogIDxyZGY6UkRGIHhtbG5zOnJkZj0iaHR0cDovL3d3dy53My5vcmcvMTk5OS8wMi8yMi1yZGYtc3ludGF4LW5zIyI+DQogICAgPHJkZjpEZXNjcmlwdGlvbiByZGY6YWJvdXQ9IiIgeG1sbnM6ZGM9Imh0dHA6Ly9wdXJsLm9yZy9kYy9lbGVtZW50cy8xLjEvIiB4bWxuczp4bXA9Imh0dHA6Ly9ucy5hZG9iZS5jb20veGFwLzEuMC8iIHhtbG5zOnhtcEdJbWc9Imh0dHA6Ly9ucy5hZG9iZS5jb20veGFwLzEuMC9nL2ltZy8iIHhtbG5zOnhtcE1NPSJodHRwOi8vbnMuYWRvYmUuY29tL3hhcC8xLjAvbW0vIiB4bWxuczpzdFJlZj0iaHR0cDovL25zLmFkb2JlLmNvbS94YXAvMS4wL3NUeXBlL1Jlc291cmNlUmVmIyIgeG1sbnM6c3RFdnQ9Imh0dHA6Ly9ucy5hZG9iZS5jb20veGFwLzEuMC9zVHlwZS9SZXNvdXJjZUV2ZW50IyIgeG1sbnM6aWxsdXN0cmF0b3I9Imh0dHA6Ly9ucy5hZG9iZS5jb20vaWxsdXN0cmF0b3IvMS4wLyIgeG1sbnM6cGRmPSJodHRwOi8vbnMuYWRvYmUuY29tL3BkZi8xLjMvIj4NCiAgICAgIDxkYzpmb3JtYXQ+aW1hZ2UvanBlZzwvZGM6Zm9ybWF0Pg0KICAgICAgPGRjOnRpdGxlPg0KICAgICAgICA8cmRmOkFsdD4NCiAgICAgICAgICA8cmRmOmxpIHhtbDpsYW5nPSJ4LWRlZmF1bHQiPlByaW50PC9yZGY6bGk+DQogICAgICAgIDwvcmRmOkFsdD4NCiAgICAgIDwvZGM6dGl0bGU+DQogICAgICA8eG1wOk1ldGFkYXRhRGF0ZT4yMDIxLTA3LTA4VDEzOjE0OjQ5KzA1OjMwPC94bXA6TWV0YWRhdGFEYXRlPg0KICAgICAgPHhtcDpNb2RpZnlEYXRlPjIwMjEtMDctMDhUMDc6NDQ6NTJaPC94bXA6TW9kaWZ5RGF0ZT4NCiAgICAgIDx4bXA6Q3JlYXRlRGF0ZT4yMDIxLTA3LTA4VDEzOjE0OjQ5KzA1OjMwPC94bXA6Q3JlYXRlRGF0ZT4NCiAgICAgIDx4bXA6Q3JlYXRvclRvb2w+QWRvYmUgSWxsdXN0cmF0b3IgQ0MgMjAxNCAoV2luZG93cyk8L3htcDpDcmVhdG9yVG9vbD4NCiAgICAgIDx4bXA6VGh1bWJuYWlscz4NCiAgICAgICAgPHJkZjpBbHQ+DQogICAgICAgICAgPHJkZjpsaSByZGY6cGFyc2VUeXBlPSJSZXNvdXJjZSI+DQogICAgICAgICAgICA8eG1wR0ltZzp3aWR0aD4yNTY8L3htcEdJbWc6d2lkdGg+DQogICAgICAgICAgICA8eG1wR0ltZzpoZWlnaHQ+Mjg8L3htcEdJbWc6aGVpZ2h0Pg0KICAgICAgICAgICAgPHhtcEdJbWc6Zm9ybWF0PkpQRUc8L3htcEdJbWc6Zm9ybWF0Pg0KICAgICAgICAgICAgPHhtcEdJbWc6aW1hZ2U+LzlqLzRBQVFTa1pKUmdBQkFnRUFTQUJJQUFELzdRQXNVR2h2ZEc5emFHOXdJRE11TUFBNFFrbE5BKzBBQUFBQUFCQUFTQUFBQUFFQQ0KQVFCSUFBQUFBUUFCLys0QURrRmtiMkpsQUdUQUFBQUFBZi9iQUlRQUJnUUVCQVVFQmdVRkJna0dCUVlKQ3dnR0JnZ0xEQW9LQ3dvSw0KREJBTURBd01EQXdRREE0UEVBOE9EQk1URkJRVEV4d2JHeHNjSHg4Zkh4OGZIeDhmSHdFSEJ3Y05EQTBZRUJBWUdoVVJGUm9mSHg4Zg0KSHg4Zkh4OGZIeDhmSHg4Zkh4OGZIeDhmSHg4Zkh4OGZIeDhmSHg4Zkh4OGZIeDhmSHg4Zkh4OGZIeDhmLzhBQUVRZ0FIQUVBQXdFUg0KQUFJUkFRTVJBZi9FQWFJQUFBQUhBUUVCQVFFQUFBQUFBQUFBQUFRRkF3SUdBUUFIQ0FrS0N3RUFBZ0lEQVFFQkFRRUFBQUFBQUFBQQ0KQVFBQ0F3UUZCZ2NJQ1FvTEVBQUNBUU1EQWdRQ0JnY0RCQUlHQW5NQkFnTVJCQUFGSVJJeFFWRUdFMkVpY1lFVU1wR2hCeFd4UWlQQg0KVXRIaE14Wmk4Q1J5Z3ZFbFF6UlRrcUt5WTNQQ05VUW5rNk96TmhkVVpIVEQwdUlJSm9NSkNoZ1poSlJGUnFTMFZ0TlZLQnJ5NC9QRQ0KMU9UMFpYV0ZsYVcxeGRYbDlXWjJocGFtdHNiVzV2WTNSMWRuZDRlWHA3ZkgxK2YzT0VoWWFIaUltS2k0eU5qbytDazVTVmxwZVltWg0KcWJuSjJlbjVLanBLV21wNmlwcXF1c3JhNnZvUkFBSUNBUUlEQlFVRUJRWUVDQU1EYlFFQUFoRURCQ0VTTVVFRlVSTmhJZ1p4Z1pFeQ0Kb2JId0ZNSFI0U05DRlZKaWN2RXpKRFJEZ2hhU1V5V2lZN0xDQjNQU05lSkVneGRVa3dnSkNoZ1pKalpGR2lka2RGVTM4cU96d3lncA0KMCtQemhKU2t0TVRVNVBSbGRZV1ZwYlhGMWVYMVJsWm1kb2FXcHJiRzF1YjJSMWRuZDRlWHA3ZkgxK2YzT0VoWWFIaUltS2k0eU5qbw0KK0RsSldXbDVpWm1wdWNuWjZma3FPa3BhYW5xS21xcTZ5dHJxK3YvYUFBd0RBUUFDRVFNUkFEOEE5UlgxN2JXRmxjWDEyNGl0YldKNQ0KNTVEMFdPTlN6TjlBR0t2UHZ5cy9NTzk4dzZscTFocWhDM0Jta3ViQ09uRXh3Z3FzbG8yd3JKYmM0K2YrdjdZcGVrWW9kaXJzVmRpcg0Kc1ZkaXJzVmRpcnNWZGlyc1ZkaXFHMVNXU0xUTHVXTnVNa2NNakl3N0ZVSkJ4VjRMcDNuaWZWTkJndnZNRitzU3l1c2JOTnpsaGFRVw0KeVRnbEQ5WTRsaTdLdkdBNzdEZk50ZzFNWXc0aUszcmI4RC9kT2kxT2luTElZQ1hGWXVwYi9mWS8ySHhUSDh2UFBsOXFYbkhTOU90cA0KSklMQjV5c3NEU0ZoSWpXbDY5R2pabkVaU1MxVS9EeFBZZ1ppNnJVUm55SHgydjhBSHpjL1I2V1dQZVIrRzlmYitnRDNQY3N3M09kaQ0KcnNWZGlyc1ZkaXEweVJoMWpMQU93SlZDUlVoYVZJSHRVWXE1NUk0MTVTTUVXb0hKaUFLazBBMzhTY1ZYWXE3RlhZcTdGWFlxN0ZYWQ0KcTg4L00zWElydlNMelRZYmlPQzJoS3lYVnpNcGVKbWdsUnpFd1hjeDhnRWw0N3NXNEtDeEl6TEdtckdaUzI3dng1OVBtNFIxZDVSQw0KSXZ2L0FFL0xyOHVmTG1Ya2k1ZTI4eVJUcklMZTV0NTVybjk2T2N4bFZKRmxna0txb0o0M0JhZCtyb3FPaWppd1dyQmpFNVVXL1U1RA0KQ0JJSDQvSDYzdDJwZWVkSDAzeXRjK1lydFpQcTlsd1c2dDQrRFNwSTdyR0YrSmtUZHBCUml3WGo4VmFZTXVJd05GY0dZWkkyUGo1Zg0KajdlYURnL05EeTBkT1cvdkk3eXdoYVV3QXpXMGtrZklTQ0pUOVl0aFBiY0pIUEZIOVhpeDZIWTVVM0tmbDc4MWZMZXU2VnErcDJzTg0KNUZiYUxiSmVYbnJSS0NZNUxjM0FFZkIzVm1DRGNWNisyK0txZW4vbTc1VHVkT2JVTGxicXd0K2FKQ1pJZnJCbTV3bTRKaU5pMTJyOA0KSWxKa29hcCszVEZXOVQvT0x5Rlkya3R5dDdKZUNOUXlwYlF5TjZ0ZlNMTEZJNFNGM1JiaEdaQS9JQTlNVlJjMzVvK1JvZVJtMUZvaw0KVTNJOVI3ZTVXTm1zMDUzQ281aUN1MFk2cXBKcnQxMnhWazl2UEhjUVJ6eEVtS1ZWZENRVkpWaFVWVmdDTnV4eFZmaXJzVmRpcnNWZA0KaXFsZFc2M05yTmJzU0ZtUm8ySTZnTUNOdnZ4Vjh0K2JQSy9tZnlyWS9vblZiV21ubzRObmZJeEZ0SklJUmJodlVxRkhPTkRXS1JrUA0KTCtkZmd5ZkdlSGg2WGJEd3h4Y1hXcVpqK1Rma1B6RSt2MlBtTzhoYTAweXlWbXRtbVVvOHdhS2VLTllZaUVJaUMzVE9YWkVCK0VJZw0KRlRrR3g3eGloMkt1eFYyS3V4VjJLdlAvQU16L0FDZ3ZtYlVOTHRQcjBsaFMwMUJacFVaRlZvSlBxL3FxL05KTmp4RzRwbVRoeHhNVA0KS1Y3RURienY5VGlaODA0empHTmJpUjM4cS9Xd3kxL0wrS1ptMWNlWTdyVUk0N3lCYnlGbWpWbjllL2p1S2tHQlR3ZWJqS0NPdmJNaQ0KV2xnRHdrU0JvbnAwRnVMSFhUTWVJR01nSkFkZXBBL1RZZW1MNXhhUFV0UWl1MWdqdExTT2FTSXE3TkxJSVNBU0tLWTk2N3J5cUQyeQ0KSDVPNHhJdXpYMi9hMmZucW5JU29SaUQxM05mWjl0aFQwL3pzYnV5MCtZcEVzdHhlRzB1eHlQR01lbThpc0NmRUtPdnZrc21pNFpTRw0KKzBiSDNNY1hhSEZHSjJzeTRUNWJFb2pTZGYxaVpkVm12WTdRUWFielV0Rkl5aDNTTlphODVLSXFjVyswY3ExR0tFQU9HN08rN2RwYw0KK1RKS1FrSTFFMXRmY0QrbDVkUCtmWG1wTk9oZE5QMDk5UWx1QkcxcW4xcVF4eHRFMGk4Z0ZYa1R3MmVObVVqd3pFYzZremcvT3ZYVw0KMVMyMGVYVGJkTDY4dTlOdGJlYjk2SUQ5Y2dqa25WcW5tam8weWxhamRhOXhpcXpVdnpYL0FEQTB6VHJ1OXZiVFNGUzAxZzZHN1IvWA0KSEFtU015dkp4VU01ajRnVW9PWHRpcWFhWCtaZm5TL2wwSzIvUWx2RE41bWlTYlRKaTcrbkdrTEg2NDh5c1VaaDZRV1dJTFRad0RVMQ0KeFZEL0FKZ2ZsOTVrdXRSUWFKRTh1bUdMbGJyQ1lBOXRjK294TGNaNUlBd0N5dDZSNUV4a3NSdndLM1pjOHAxYlJoMDhNWkpIWDhWNw0KcnY1cERjK1FQUFU4dG5KK2gzaFd3aFdHQ08wRmxhbWtKTFFONmkzc2hWNFpEeVNUaVNLbXZJTXltbHZlbGFmNUhaL0tMYVJxZDNKRg0KcUY1QkRIcUY3cDdlaVEwUUE0UTFVajB4UWppeTBZRTFHNXk3TG5sT3I2T1BoMDhjZDhQWDlISWU0SkYveW9QeWEwNG5rdWIxM014bg0KbUgraW9zanRJa3BvaVc2TEZ2RW8vY2hLalk1UzNwMTVYL0xIUnZMVmxxVm5wMTlmK2xxY01VRXJOTEdza2Zvdytnc2tNa1VjVG8vSA0KdlhydUtZcWswMzVDK1RwNFpWbnVMdVc0bGVObXVtRm56cEZDOEFYMHhiQ0ExV1FrdTBaZmxSdVZSaXE2ZjhpZkowdW14YWN0eGZRMg0KMEU4MXhDSTVJcXEwOGNNUlVGb20rRlZ0azQxMzYxSnhXMnZNUDVRMnQ1b09qZVg3Ti9Wc0xMVkRxRjVkWGNsSi9TbGtkNTQ0eEZEdw0KYjFQVkswUEVEYnJpcjBmRlhZcTdGWFlxN0ZYai93Q1kvbWE2MEg4d2JTN2ZWSnJtMEVWdXFhRmFYTThFMFQ4cEhNNzJxRDA3dUVoUA0KM2dMQmh0dUIxVXNMMXI4My9ObXU2UGJYbHRkL1VMMjJPb3F5NmV6UkxJaTJjTTBUeVJDVzQzVW1TbFhQUTlDRGlyTnZ6WDErYURTLw0KTDJwcHIwVnhhbU9lU2V6MDY2bTA4NmlmM2FxOXBKRWJnRXhzM0pZM2NnKytLRXJuL09yenkyc1htbld0bHAwSWgxRVdFU3pwSkpMRw0KdnF5eGoxVVM1RHMxSTFQSXFuZWdOUWNVMHQwUDgxUE45N3FwYUc3c29adFl1OUdoaDAyNmlsbjlCTDJ5VXpUd0t0eEEzcENZZE45eg0KOXF1S3M2L0xiemw1bzh4M2Vzd2F6WlFXZzBhVVdNclFySVBVdTBaL1dLbDNmNEFucGtEcnYxeFF6ckZYWXE3RlhZcXgzem41Y20xZQ0KeVY3WnY5SmdTUkJBVHhXV09RcVhUbCt5MVkxS25wWFlpaHpNMGVvR09XL0kvWitMZGYyaHBEbGpZNWk5dThHckgyRDlPeVJhUm8ydQ0KNnpxaVhPcVJHMWd0NHJSSkg0aU5wREdzYy9wS2dBMkUyN01mRGl0Tjh5OHViSGpoVURaSmwra1g4djFsd2NHRExtbnhaQndnQ1B4cQ0KcFYvcHVaK0E2c3piUmRJYWFXWTJVQm1tSU0wbnBweWNxd1ljalRmNGhYTlo0MDZxelFkeCtYeDJUd2l6NU91OUYwaThMbTdzb1p6SQ0KeXM1a2pWcXNnS3FUVWRRQ1FNTU0wNDhpUXVUVDQ1L1ZFSDNoVXQ5TjArMmdlQzN0b29vSk5wSWtSVlZoeENiZ0NoK0VBWkdjNVM1bQ0KMmVQRkdBcUlBOXlUeWZsOTVGa3RqYk41ZjA4MjVrTXhpK3JSQmZVSXB5b0Y2MHlETkdXM2xUeXpiSXNkdnBWcEVpU1F6b0ZoakhHVw0KMlVKRElOdG1qVlFGUGJGVlUrWDlETlNkUHR5VGRmWHorNlQvQUhycHg5ZnAvZVUyNWRjVmRiYUJvbHI5VCtyV0Z2RCtqeEl0aHdqVg0KZlFFMzk0SXFENE9mN1ZPdUtvL0ZYWXE3RlhZcTdGWFlxN0ZYWXE3RlhZcTdGWFlxN0ZYWXE3RlhZcTdGWFlxeC93QWtmNFUvUk0zKw0KR2VYMVQ2MVA5YjlYNng2LzF2bCsrOWY2MSsvOVN2WG52aXJJTVZkaXJzVmRpcnNWZGlyc1ZkaXJzVmRpcnNWZGlyc1ZmLy9aPC94bXBHSW1nOmltYWdlPg0KICAgICAgICAgIDwvcmRmOmxpPg0KICAgICAgICA8L3JkZjpBbHQ+DQogICAgICA8L3htcDpUaHVtYm5haWxzPg0KICAgICAgPHhtcE1NOkluc3RhbmNlSUQ+eG1wLmlpZDpjY2IyM2U4ZS01NTYyLTFiNDktODY5Zi05MjA5OTM3Yzg1OTU8L3htcE1NOkluc3RhbmNlSUQ+DQogICAgICA8eG1wTU06RG9jdW1lbnRJRD54bXAuZGlkOmNjYjIzZThlLTU1NjItMWI0OS04NjlmLTkyMDk5MzdjODU5NTwveG1wTU06RG9jdW1lbnRJRD4NCiAgICAgIDx4bXBNTTpPcmlnaW5hbERvY3VtZW50SUQ+dXVpZDo1RDIwODkyNDkzQkZEQjExOTE0QTg1OTBEMzE1MDhDODwveG1wTU06T3JpZ2luYWxEb2N1bWVudElEPg0KICAgICAgPHhtcE1NOlJlbmRpdGlvbkNsYXNzPnByb29mOnBkZjwveG1wTU06UmVuZGl0aW9uQ2xhc3M+DQogICAgICA8eG1wTU06RGVyaXZlZEZyb20gcmRmOnBhcnNlVHlwZT0iUmVzb3VyY2UiPg0KICAgICAgICA8c3RSZWY6aW5zdGFuY2VJRD54bXAuaWlkOmUxMTk2ZGQ0LTc2OGEtNzg0NC05YTg5LTA1NzYwYWQ1NzZjOTwvc3RSZWY6aW5zdGFuY2VJRD4NCiAgICAgICAgPHN0UmVmOmRvY3VtZW50SUQ+eG1wLmRpZDplMTE5NmRkNC03NjhhLTc4NDQtOWE4OS0wNTc2MGFkNTc2Yzk8L3N0UmVmOmRvY3VtZW50SUQ+DQogICAgICAgIDxzdFJlZjpvcmlnaW5hbERvY3VtZW50SUQ+dXVpZDo1RDIwODkyNDkzQkZEQjExOTE0QTg1OTBEMzE1MDhDODwvc3RSZWY6b3JpZ2luYWxEb2N1bWVudElEPg0KICAgICAgICA8c3RSZWY6cmVuZGl0aW9uQ2xhc3M+cHJvb2Y6cGRmPC9zdFJlZjpyZW5kaXRpb25DbGFzcz4NCiAgICAgIDwveG1wTU06RGVyaXZlZEZyb20+DQogICAgICA8eG1wTU06SGlzdG9yeT4NCiAgICAgICAgPHJkZjpTZXE+DQogICAgICAgICAgPHJkZjpsaSByZGY6cGFyc2VUeXBlPSJSZXNvdXJjZSI+DQogICAgICAgICAgICA8c3RFdnQ6YWN0aW9uPnNhdmVkPC9zdEV2dDphY3Rpb24+DQogICAgICAgICAgICA8c3RFdnQ6aW5zdGFuY2VJRD54bXAuaWlkOmUxMTk2ZGQ0LTc2OGEtNzg0NC05YTg5LTA1NzYwYWQ1NzZjOTwvc3RFdnQ6aW5zdGFuY2VJRD4NCiAgICAgICAgICAgIDxzdEV2dDp3aGVuPjIwMjEtMDctMDhUMTA6NDA6MjArMDU6MzA8L3N0RXZ0OndoZW4+DQogICAgICAgICAgICA8c3RFdnQ6c29mdHdhcmVBZ2VudD5BZG9iZSBJbGx1c3RyYXRvciBDQyAyMDE0IChXaW5kb3dzKTwvc3RFdnQ6c29mdHdhcmVBZ2VudD4NCiAgICAgICAgICAgIDxzdEV2dDpjaGFuZ2VkPi88L3N0RXZ0OmNoYW5nZWQ+DQogICAgICAgICAgPC9yZGY6bGk+DQogICAgICAgICAgPHJkZjpsaSByZGY6cGFyc2VUeXBlPSJSZXNvdXJjZSI+DQogICAgICAgICAgICA8c3RFdnQ6YWN0aW9uPnNhdmVkPC9zdEV2dDphY3Rpb24+DQogICAgICAgICAgICA8c3RFdnQ6aW5zdGFuY2VJRD54bXAuaWlkOmNjYjIzZThlLTU1NjItMWI0OS04NjlmLTkyMDk5MzdjODU5NTwvc3RFdnQ6aW5zdGFuY2VJRD4NCiAgICAgICAgICAgIDxzdEV2dDp3aGVuPjIwMjEtMDctMDhUMTM6MTQ6NDkrMDU6MzA8L3N0RXZ0OndoZW4+DQogICAgICAgICAgICA8c3RFdnQ6c29mdHdhcmVBZ2VudD5BZG9iZSBJbGx1c3RyYXRvciBDQyAyMDE0IChXaW5kb3dzKTwvc3RFdnQ6c29mdHdhcmVBZ2VudD4NCiAgICAgICAgICAgIDxzdEV2dDpjaGFuZ2VkPi88L3N0RXZ0OmNoYW5nZWQ+DQogICAgICAgICAgPC9yZGY6bGk+DQogICAgICAgIDwvcmRmOlNlcT4NCiAgICAgIDwveG1wTU06SGlzdG9yeT4NCiAgICAgIDxpbGx1c3RyYXRvcjpTdGFydHVwUHJvZmlsZT5QcmludDwvaWxsdXN0cmF0b3I6U3RhcnR1cFByb2ZpbGU+DQogICAgICA8cGRmOlByb2R1Y2VyPkFkb2JlIFBERiBsaWJyYXJ5IDEwLjAxPC9wZGY6UHJvZHVjZXI+DQogICAgPC9yZGY6RGVzY3JpcHRpb24+DQogIDwvcmRmOlJERj4NCjwveDp4bXBtZXRhPg0KPD94cGFja2V0IGVuZD0iciI/Pv/bAEMAAgEBAQEBAgEBAQICAgICBAMCAgICBQQEAwQGBQYGBgUGBgYHCQgGBwkHBgYICwgJCgoKCgoGCAsMCwoMCQoKCv/bAEMBAgICAgICBQMDBQoHBgcKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCgoKCv/AABEIACIAiQMBIQACEQEDEQH/xAAfAAABBQEBAQEBAQAAAAAAAAAAAQIDBAUGBwgJCgv/xAC1EAACAQMDAgQDBQUEBAAAAX0BAgMABBEFEiExQQYTUWEHInEUMoGRoQgjQrHBFVLR8CQzYnKCCQoWFxgZGiUmJygpKjQ1Njc4OTpDREVGR0hJSlNUVVZXWFlaY2RlZmdoaWpzdHV2d3h5eoOEhYaHiImKkpOUlZaXmJmaoqOkpaanqKmqsrO0tba3uLm6wsPExcbHyMnK0tPU1dbX2Nna4eLj5OXm5+jp6vHy8/T19vf4+fr/xAAfAQADAQEBAQEBAQEBAAAAAAAAAQIDBAUGBwgJCgv/xAC1EQACAQIEBAMEBwUEBAABAncAAQIDEQQFITEGEkFRB2FxEyIygQgUQpGhscEJIzNS8BVictEKFiQ04SXxFxgZGiYnKCkqNTY3ODk6Q0RFRkdISUpTVFVWV1hZWmNkZWZnaGlqc3R1dnd4eXqCg4SFhoeIiYqSk5SVlpeYmZqio6Slpqeoqaqys7S1tre4ubrCw8TFxsfIycrS09TV1tfY2dri4+Tl5ufo6ery8/T19vf4+fr/2gAMAwEAAhEDEQA/AP0+/as/4KYeGf2Q/wBuPwj8FfjT4q0Xw78P9c8GXWpahrt/bzPLHeLJsijUxhvlYZ/h7V4b8Nf+Di34I6ho2gSfEc6JbXurfES+0jVEtLi4VdK0WPb5GpNmNt4fJ+UcjHQUE80e5k/E7/g4a8EWfgz4wzfDbxF4Wm1fwz4gt7b4XRyQ3TL4jsmcCSdgVAUqvYlT7V+mXg7WZ9d8J6brl2oWW8sIZpFXoGdAxA/OjrYo0vMTqTRvX1oAPMXGc0eYvWi4C7hjJo3CgALD1oDZOMUAG5c4zS5HrQAZGM0m5cZJoAXcPWigD5B/a4+Elp8fP2v/AAz8LNSbSYY5fCs9x9svfDNlfyIUk+6DcRMQDnoDiuK+JP7Cv7PPwh1XSND8f/GHwvplxrd15FhFN8ONH+ZvVv8AR/lXPG48ZPWvusFUy2lQoYZYGNacoczfNJN7vZO2iR+T5lDOa2IxWLnm0sPRhU5ElGDS+FLVq7u31KH7S37Avhn4BfB3Ufipp+s+G9SksWiMdvJ8O9IVX3OB1Fvx1r379qr48eN/gl8J/CepeFJrfTYdUuoLXU9fn043EWmRGPO8xLjqRgdv0FTGnlWdYjCqnhlSUpSi1GT96yTSu72vsFTFcQcOYfG+2xjruMISjKUY+7d2btFK6S1Zvfs0fFHxH4r8F6x4r8W/Gfwx4s02zffZ6noNuYXiiCbm+0Rk5Rvb0Ga8z/Z1/bJ+JnjH48RaF8S7SGDwv40W7fwLMkIVgYJCuxj1O5ASCfQY61z/ANjYOpUxidOVN017sZO7Ulq0++idvI65cUZlh6eW2qwqqq/fnBWi4vRNJ3a1av56HofwZ+Mfjvxp+0x8SPhnrd9E+l+HUszpUawAMnmBt2T/ABdBXnvxF8Z/ta+F/wBpXw38DrL44aX5PiqG6uLa6bw4n+ipGsjhCN3zcLjORWmDweT0MdKniKTmvZKatJrXkUn9/TsTmWZcRYjKqdfB4hU5OtKm7wTunPlW70sl8z1f9oT4hfFb9n/9kbxV8TND0xfFni3wz4VnvILeG1KrfXEaZz5ac7R94qOwNfIf/BMr9uz49ftUeKtN1bxJ+2f8N/Ecd1oM974k+Hcfht9P1fSbkJlYoNzf6RGrfecZwAPXj4+pyyqNwVlfRdvI/SqMakaMVUd5JJN7Xff59jxn9jb/AIKY/tC/tIaHorfET/gp94J8G+K9Y8QPp8Pgi6+HLTzv+/8ALiHmp8mZBjHPGea9Rk/4K3/Fz4Mf8FS/Gv7PvxyWC4+E1jrVjosGtQ2Ij/sS8uYFaF5ZB1jdw4Jbp+FTY1Ox/Z5/aA/bd/bA8I/HK3+H/wAfdG8M6h8O/jPqOmaPqM3hmO7R9HggJS327gCxYqfM64HvxyX7I37Q/wDwUU+KP7GPiT9uDx7+0zoN1puj6L4k8rwvD4NjjdrizFxDDJ5wfoJY1crt5Ax3zRYDgtS/4KCft8fBj9mH4Z/th+I/2q/AXjJPGGr6db3fwxXw7FDqEkdySGWJo5C5dcddoHP0B9X+P/8AwU5+Nf7Afxn+JHw3/aY05tetda0T+1vgTcWOk4OoXDsIhpshjHLrI6kk4O1W9VzVgPrn9ji1/aKH7PPh3Uv2qdbt7zx1f2gvNahtbVIY7JpPmFsAvGUUhSeckGvUtz/3D+n+NZgfLP7R3ii6+HX7anhXxjNFDD9s8J3ljpFxqDGO1lvmbMcTyYIXJAH4j1rkPgr4V+FHx8f4geJf2wtRV/Gln51vrFjqUnkx6HZKSUa154XAB3jr3znJ/RMKsThMqhjMJrV5IJNdFztSt3d7J+T8z8TzH6njuIKuXZi0sO6k5ST6y5E438rXafdHnOv/ABV8Wap+y54l+FUmsXmseGbzWIrD4aXmowsNQ1JFlXMaIBl0UcB+3C9sD7N+JXgr4v8Aib4daPp/ws8Q6TY3VrDH9u0/XtMFxb3ibMeU/wDc55yOawzqng8DiKUq0XyOcpNRdne0VLlfZSvb0Orhapmea4fEU8PNc8acYxlNXTipPl5l/eha67M8h0H9iD4v6L4Q8e3djr3h3Tde8eLb201josL29hYW6sfMKADl2Vm7Dk1Y8Q/8E3NK8N6Dout/CDxxqy+J/Dd3b3Gk/wBtas0tnGVdTIqx7fkDAHp9KqXGFKnVkqULxm7Sc1zS5VFRVn/NuOPhriq1GEq9VRnTV4KDcYKbm5tNWfurRJF63+AX7WHgT43eKvix8Mb3wey+KY7YXEOrSTMYzGvbavqT9RiuhuvgB8YfFfx/+Hnxu8Zajoqy+G9LuodahsWfa8skcigxAjkfOOpFcGIzTI5RVWkp+0cHB3tb4eVW1PVwfDvFSvh8RKl7FVFUi1fm+Pmd9LHqPxb8OfEDxV8NNa8OfC3xvH4b8Q3mnyRaRr0litytjOR8svlN8r49Dx9a+J/h7/wTH/ah8X/taeEf2j/2kfEnwxs7jwK1zJBqXw98NtY3viOaSNkD3h4AHzEkfNyT2Jr5BH6YcJ+yX/wTc/4KN/sjfD3T/hz4T8F/s860un6tNewa94g0mWfUFaSXzOJfKyCp+76YGK9p0X/glzP45+Pn7Rnif4/NpGoeD/jRZ6dFp9pZMxubOS3jI807lAVlfDKQT0+tAFz/AIJaf8E6viV+wZ8IPid8KvG/jex17/hKvFlxf6LqEMjs7W7WyQoZww4kJXLYJ+tWv2Z/2C/it8G/+Cafib9jnxFr+jzeItZt/EMdteWszm2U3007xbiVDcCRc8ce9O6A8I8Mf8ELL/4IWHwS+M37P2m+EbT4o/D++hk8bR6tJNcaZ4gXBEkmJFfy5Rn5GVVwSGGGRTX0b+31+xN8Q/2rvit8CviB4TvNFt4fhr48i1vX4tSdt01uHhYxxYU7jmM8HAPFDYH1IoIGDRUgcj8Yfg54G+OHga78A+PdL+0Wdyvysh2yQSD7siMOQw/+t0r4X+MnwK+N3w98Q+KvC/i4XHiC3/4QZrHw3q8NqWmvYRdReXFIVGWlUEL6kAda+24TzSjSjLC4h6XTi+2seZPya19Ufk/iJw/iKzhmGDjdv3akbX5lyvlfyenoz6C/ZC/ZN8S6C2l/Fv8AaAnS88SWemRWmhaSuPs+i2qxhQqoPl8w4yzY6k9TzX0hEgQ8CvD4gzCnj8ylKirU4+7FeS6vzb1Z9bwbktbJslhGvrWn7035tLT0SskSUV4p9WFFABRQAUUAFFABRQAUUAMI/dnimCGGX5pYlYrnbuXOOamLd2Kye/kEBJUZPr/OpV+naqWw5fExaKACigAooAKKACigAooAKKAP/9k=\"></img>";
-  page += FPSTR(HTTP_PORTAL_OPTIONS);
-  page += FPSTR(HTTP_END);
-
-  server->send(200, "text/html", page);
-
-
+  WiFiManagerPage page(*server);
+  pageStart(page, "Options");
+  page.print_P(PSTR("<img style=\"display: block;  margin-left: auto; margin-right: auto; margin-botom: 5px;  width: 70%;\" src=\"/logo.jpg\"></img>"));
+  page.print_P(HTTP_PORTAL_OPTIONS);
+  page.end();
+}
 
+/** Start a portal page: header with the title, script, style and the custom head element */
+void WiFiManager::pageStart(WiFiManagerPage& page, const char* title) {
+  const char* values[] = { title };
+  page.printTemplate(HTTP_HEADER, "v", values);
+  page.print_P(HTTP_SCRIPT);
+  page.print_P(HTTP_STYLE);
+  page.print(_customHeadElement);
+  page.print_P(HTTP_HEAD_END);
 }
 
 /** Wifi config page handler */
 void WiFiManager::handleWifi(boolean scan) {
-
-  String page = FPSTR(HTTP_HEADER);
-  page.replace("{v}", "Configure Salt sentry");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Configure Salt sentry");
 
   if (scan) {
-    int n = WiFi.scanNetworks();
-    DEBUG_WM(F("Scan done"));
-    if (n == 0) {
+    if (!_scanDone || _scanCount == 0 || millis() - _scanTime > WM_SCAN_MAX_AGE) {
+      startScan();
+    }
+    if (!_scanDone) {
+      // first scan still running, the list is shown as soon as it is there
+      page.print_P(PSTR("<meta http-equiv='refresh' content='2'>Scanning for networks...<br/>"));
+    } else if (_scanCount == 0) {
       DEBUG_WM(F("No networks found"));
-      page += F("No networks found. Refresh to scan again.");
+      page.print_P(PSTR("No networks found. Refresh to scan again."));
     } else {
-
-      //sort networks
-      int indices[n];
-      for (int i = 0; i < n; i++) {
-        indices[i] = i;
-      }
-
-      // RSSI SORT
-
-      // old sort
-      for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
-          if (WiFi.RSSI(indices[j]) > WiFi.RSSI(indices[i])) {
-            std::swap(indices[i], indices[j]);
-          }
-        }
-      }
-
-      /*std::sort(indices, indices + n, [](const int & a, const int & b) -> bool
-        {
-        return WiFi.RSSI(a) > WiFi.RSSI(b);
-        });*/
-
-      // remove duplicates ( must be RSSI sorted )
-      if (_removeDuplicateAPs) {
-        String cssid;
-        for (int i = 0; i < n; i++) {
-          if (indices[i] == -1) continue;
-          cssid = WiFi.SSID(indices[i]);
-          for (int j = i + 1; j < n; j++) {
-            if (cssid == WiFi.SSID(indices[j])) {
-              DEBUG_WM("DUP AP: " + WiFi.SSID(indices[j]));
-              indices[j] = -1; // set dup aps to index -1
-            }
-          }
-        }
-      }
-
-      //display networks in page
-      for (int i = 0; i < n; i++) {
-        if (indices[i] == -1) continue; // skip dups
-        DEBUG_WM(WiFi.SSID(indices[i]));
-        DEBUG_WM(WiFi.RSSI(indices[i]));
-        int quality = getRSSIasQuality(WiFi.RSSI(indices[i]));
-
-        if (_minimumQuality == -1 || _minimumQuality < quality) {
-          String item = FPSTR(HTTP_ITEM);
-          String rssiQ;
-          rssiQ += quality;
-          item.replace("{v}", WiFi.SSID(indices[i]));
-          item.replace("{r}", rssiQ);
-          if (WiFi.encryptionType(indices[i]) != ENC_TYPE_NONE) {
-            item.replace("{i}", "l");
-          } else {
-            item.replace("{i}", "");
-          }
-          //DEBUG_WM(item);
-          page += item;
-          delay(0);
+      //display networks in page, the cached list is already sorted and without duplicates
+      char quality[4];
+      for (int i = 0; i < _scanCount; i++) {
+        int q = getRSSIasQuality(_scanResults[i].rssi);
+
+        if (_minimumQuality == -1 || _minimumQuality < q) {
+          snprintf(quality, sizeof(quality), "%d", q);
+          const char* values[] = { _scanResults[i].ssid, quality, _scanResults[i].encrypted ? "l" : "" };
+          page.printTemplate(HTTP_ITEM, "vri", values);
         } else {
           DEBUG_WM(F("Skipping due to quality"));
         }
-
       }
-      page += "<br/>";
+      page.print("<br/>");
     }
   }
 
-  page += FPSTR(HTTP_FORM_START);
-  char parLength[2];
+  page.print_P(HTTP_FORM_START);
+  char parLength[4];
   // add the extra parameters to the form
   for (int i = 0; i < _paramsCount; i++) {
     if (_params[i] == NULL) {
       break;
     }
 
-    String pitem = FPSTR(HTTP_FORM_PARAM);
     if (_params[i]->getID() != NULL) {
-      pitem.replace("{i}", _params[i]->getID());
-      pitem.replace("{n}", _params[i]->getID());
-      pitem.replace("{p}", _params[i]->getPlaceholder());
-      snprintf(parLength, 2, "%d", _params[i]->getValueLength());
-      pitem.replace("{l}", parLength);
-      pitem.replace("{v}", _params[i]->getValue());
-      pitem.replace("{c}", _params[i]->getCustomHTML());
+      snprintf(parLength, sizeof(parLength), "%d", _params[i]->getValueLength());
+      const char* values[] = { _params[i]->getID(), _params[i]->getID(), _params[i]->getPlaceholder(), parLength, _params[i]->getValue(), _params[i]->getCustomHTML() };
+      page.printTemplate(HTTP_FORM_PARAM, "inplvc", values);
     } else {
-      pitem = _params[i]->getCustomHTML();
+      page.print(_params[i]->getCustomHTML());
     }
-
-    page += pitem;
   }
   if (_params[0] != NULL) {
-    page += "<br/>";
+    page.print("<br/>");
   }
 
   if (_sta_static_ip) {
-
-    String item = FPSTR(HTTP_FORM_PARAM);
-    item.replace("{i}", "ip");
-    item.replace("{n}", "ip");
-    item.replace("{p}", "Static IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _sta_static_ip.toString());
-
-    page += item;
-
-    item = FPSTR(HTTP_FORM_PARAM);
-    item.replace("{i}", "gw");
-    item.replace("{n}", "gw");
-    item.replace("{p}", "Static Gateway");
-    item.replace("{l}", "15");
-    item.replace("{v}", _sta_static_gw.toString());
-
-    page += item;
-
-    item = FPSTR(HTTP_FORM_PARAM);
-    item.replace("{i}", "sn");
-    item.replace("{n}", "sn");
-    item.replace("{p}", "Subnet");
-    item.replace("{l}", "15");
-    item.replace("{v}", _sta_static_sn.toString());
-
-    page += item;
-
-    page += "<br/>";
+    char address[16];
+    formatIp(address, sizeof(address), _sta_static_ip);
+    const char* ip[] = { "ip", "ip", "Static IP", "15", address, "" };
+    page.printTemplate(HTTP_FORM_PARAM, "inplvc", ip);
+    formatIp(address, sizeof(address), _sta_static_gw);
+    const char* gw[] = { "gw", "gw", "Static Gateway", "15", address, "" };
+    page.printTemplate(HTTP_FORM_PARAM, "inplvc", gw);
+    formatIp(address, sizeof(address), _sta_static_sn);
+    const char* sn[] = { "sn", "sn", "Subnet", "15", address, "" };
+    page.printTemplate(HTTP_FORM_PARAM, "inplvc", sn);
+    page.print("<br/>");
   }
 
-  page += FPSTR(HTTP_FORM_END);
-  page += FPSTR(HTTP_SCAN_LINK);
-
-  page += FPSTR(HTTP_END);
-
-  server->send(200, "text/html", page);
-
+  page.print_P(HTTP_FORM_END);
+  page.print_P(HTTP_SCAN_LINK);
+  page.end();
 
   DEBUG_WM(F("Sent config page"));
 }
@@ -542,8 +967,9 @@ void WiFiManager::handleWifiSave() {
     }
     //read parameter
     String value = server->arg(_params[i]->getID()).c_str();
-    //store it in array
-    value.toCharArray(_params[i]->_value, _params[i]->_length);
+    //store it in array, _length characters fit next to the terminating 0
+    value.toCharArray(_params[i]->_value, _params[i]->_length + 1);
+    _params[i]->_truncated = value.length() > (unsigned int)_params[i]->_length;
     DEBUG_WM(F("Parameter"));
     DEBUG_WM(_params[i]->getID());
     DEBUG_WM(value);
@@ -569,16 +995,10 @@ void WiFiManager::handleWifiSave() {
     optionalIPFromString(&_sta_static_sn, sn.c_str());
   }
 
-  String page = FPSTR(HTTP_HEADER);
-  page.replace("{v}", "Credentials Saved");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += FPSTR(HTTP_SAVED);
-  page += FPSTR(HTTP_END);
-
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Credentials Saved");
+  page.print_P(HTTP_SAVED);
+  page.end();
 
   DEBUG_WM(F("Sent wifi save page"));
 
@@ -589,38 +1009,33 @@ void WiFiManager::handleWifiSave() {
 void WiFiManager::handleInfo() {
   DEBUG_WM(F("Info"));
 
-  String page = FPSTR(HTTP_HEADER);
-  page.replace("{v}", "Info");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += F("<dl>");
-  page += F("<dt>Chip ID</dt><dd>");
-  page += ESP.getChipId();
-  page += F("</dd>");
-  page += F("<dt>Flash Chip ID</dt><dd>");
-  page += ESP.getFlashChipId();
-  page += F("</dd>");
-  page += F("<dt>IDE Flash Size</dt><dd>");
-  page += ESP.getFlashChipSize();
-  page += F(" bytes</dd>");
-  page += F("<dt>Real Flash Size</dt><dd>");
-  page += ESP.getFlashChipRealSize();
-  page += F(" bytes</dd>");
-  page += F("<dt>Soft AP IP</dt><dd>");
-  page += WiFi.softAPIP().toString();
-  page += F("</dd>");
-  page += F("<dt>Soft AP MAC</dt><dd>");
-  page += WiFi.softAPmacAddress();
-  page += F("</dd>");
-  page += F("<dt>Station MAC</dt><dd>");
-  page += WiFi.macAddress();
-  page += F("</dd>");
-  page += F("</dl>");
-  page += FPSTR(HTTP_END);
-
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Info");
+  char value[24];
+  page.print_P(PSTR("<dl><dt>Chip ID</dt><dd>"));
+  snprintf(value, sizeof(value), "%u", ESP.getChipId());
+  page.print(value);
+  page.print_P(PSTR("</dd><dt>Flash Chip ID</dt><dd>"));
+  snprintf(value, sizeof(value), "%u", ESP.getFlashChipId());
+  page.print(value);
+  page.print_P(PSTR("</dd><dt>IDE Flash Size</dt><dd>"));
+  snprintf(value, sizeof(value), "%u", ESP.getFlashChipSize());
+  page.print(value);
+  page.print_P(PSTR(" bytes</dd><dt>Real Flash Size</dt><dd>"));
+  snprintf(value, sizeof(value), "%u", ESP.getFlashChipRealSize());
+  page.print(value);
+  page.print_P(PSTR(" bytes</dd><dt>Soft AP IP</dt><dd>"));
+  formatIp(value, sizeof(value), WiFi.softAPIP());
+  page.print(value);
+  page.print_P(PSTR("</dd><dt>Soft AP MAC</dt><dd>"));
+  uint8_t mac[6];
+  formatMac(value, sizeof(value), WiFi.softAPmacAddress(mac));
+  page.print(value);
+  page.print_P(PSTR("</dd><dt>Station MAC</dt><dd>"));
+  formatMac(value, sizeof(value), WiFi.macAddress(mac));
+  page.print(value);
+  page.print_P(PSTR("</dd></dl>"));
+  page.end();
 
   DEBUG_WM(F("Sent info page"));
 }
@@ -629,15 +1044,10 @@ void WiFiManager::handleInfo() {
 void WiFiManager::handleReset() {
   DEBUG_WM(F("Reset"));
 
-  String page = FPSTR(HTTP_HEADER);
-  page.replace("{v}", "Info");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += F("Module will reset in a few seconds.");
-  page += FPSTR(HTTP_END);
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Info");
+  page.print_P(PSTR("Module will reset in a few seconds."));
+  page.end();
 
   DEBUG_WM(F("Sent reset page"));
   delay(5000);
@@ -711,6 +1121,10 @@ void WiFiManager::setRemoveDuplicateAPs(boolean removeDuplicates) {
   _removeDuplicateAPs = removeDuplicates;
 }
 
+void WiFiManager::setFastConnect(boolean fastConnect) {
+  _fastConnect = fastConnect;
+}
+
 
 
 template <typename Generic>
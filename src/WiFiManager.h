@@ -22,14 +22,14 @@ extern "C" {
   #include "user_interface.h"
 }
 
+#include "WiFiManagerAssets.h"  // HTTP_STYLE and HTTP_SCRIPT, generated from web/ by tools/webassets.py
+
 const char HTTP_HEADER[] PROGMEM            = "<!DOCTYPE html><html lang=\"en\"><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1, user-scalable=no\"/><title>{v}</title>";
-const char HTTP_STYLE[] PROGMEM           = "<style>.c{text-align: center;} div,input{padding:5px;font-size:1em;} input{width:95%;} body{text-align: center;font-family:verdana;} button{border:0;border-radius:0.3rem;background-color:#1fa3ec;color:#fff;line-height:2.4rem;font-size:1.2rem;width:100%;} .q{float: right;width: 64px;text-align: right;} .l{background: url(\"data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAACAAAAAgCAMAAABEpIrGAAAALVBMVEX///8EBwfBwsLw8PAzNjaCg4NTVVUjJiZDRUUUFxdiZGSho6OSk5Pg4eFydHTCjaf3AAAAZElEQVQ4je2NSw7AIAhEBamKn97/uMXEGBvozkWb9C2Zx4xzWykBhFAeYp9gkLyZE0zIMno9n4g19hmdY39scwqVkOXaxph0ZCXQcqxSpgQpONa59wkRDOL93eAXvimwlbPbwwVAegLS1HGfZAAAAABJRU5ErkJggg==\") no-repeat left center;background-size: 1em;}</style>";
-const char HTTP_SCRIPT[] PROGMEM          = "<script>function c(l){document.getElementById('s').value=l.innerText||l.textContent;document.getElementById('p').focus();}</script>";
 const char HTTP_HEAD_END[] PROGMEM        = "</head><body><div style='text-align:left;display:inline-block;min-width:260px;'>";
 const char HTTP_PORTAL_OPTIONS[] PROGMEM  = "<form action=\"/wifi\" method=\"get\"><button>Configure WiFi</button></form><br/><form action=\"/0wifi\" method=\"get\"><button>Configure WiFi (No Scan)</button></form><br/>";
 const char HTTP_ITEM[] PROGMEM            = "<div><a href='#p' onclick='c(this)'>{v}</a>&nbsp;<span class='q {i}'>{r}%</span></div>";
-const char HTTP_FORM_START[] PROGMEM      = "<form method='get' action='wifisave'><input id='s' name='s' length=32 placeholder='SSID'><br/><input id='p' name='p' length=64 type='password' placeholder='password'><br/>";
-const char HTTP_FORM_PARAM[] PROGMEM      = "<br/><input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}>";
+const char HTTP_FORM_START[] PROGMEM      = "<form method='get' action='wifisave'><input id='s' name='s' maxlength=32 placeholder='SSID'><br/><input id='p' name='p' maxlength=64 type='password' placeholder='password'><br/>";
+const char HTTP_FORM_PARAM[] PROGMEM      = "<br/><input id='{i}' name='{n}' maxlength={l} placeholder='{p}' value='{v}' {c}>";
 const char HTTP_FORM_END[] PROGMEM        = "<br/><button type='submit'>save</button></form>";
 const char HTTP_SCAN_LINK[] PROGMEM       = "<br/><div class=\"c\"><a href=\"/wifi\">Scan</a></div>";
 const char HTTP_SAVED[] PROGMEM           = "<div>Credentials Saved<br />Trying to connect the Salt sentry to network.<br />If it fails reconnect to the \"SaltSentry\" access point to try again</div>";
@@ -37,22 +37,64 @@ const char HTTP_END[] PROGMEM             = "</div></body></html>";
 
 #define WIFI_MANAGER_MAX_PARAMS 20
 
+// portal pages are sent in chunks of this size, from a stack buffer
+#define WM_PAGE_CHUNK_SIZE 256
+
+class WiFiManagerPage;
+
+// fast reconnect cache (access point, channel and ip lease) in RTC user memory, 9 blocks from this offset.
+// RTC memory survives deep sleep and resets but not a power cycle; keep the sketch's own RTC data clear of it
+#define WM_FAST_CONNECT_RTC_OFFSET 112
+#define WM_FAST_CONNECT_TIMEOUT    3000 // ms, a direct connect normally takes a few hundred
+// the cached lease is applied as a static address, DHCP is off until it is restarted this long after the
+// fast reconnect (ms); a lease is used for at most WM_FAST_CONNECT_MAX_REUSES fast reconnects, then a
+// full connect gets a new one, so a device that resets before the restart does not outlive its lease
+#define WM_FAST_CONNECT_DHCP_DELAY 60000
+#define WM_FAST_CONNECT_MAX_REUSES 8
+
+// credentials of this many networks are remembered in the SDK access point store of WM_SDK_AP_SLOTS
+#define WM_MAX_CREDENTIALS 3
+#define WM_SDK_AP_SLOTS    5
+
+// roaming: when the signal stays below the threshold for WM_ROAM_WEAK_SAMPLES checks, scan in the background
+// and move to an access point of a known network that is at least WM_ROAM_HYSTERESIS dB stronger
+#define WM_ROAM_RSSI_THRESHOLD  -75     // dBm
+#define WM_ROAM_CHECK_INTERVAL  10000   // ms between signal checks
+#define WM_ROAM_WEAK_SAMPLES    3
+#define WM_ROAM_HYSTERESIS      8       // dB
+#define WM_ROAM_MIN_INTERVAL    300000  // ms between roaming scans
+#define WM_ROAM_CONNECT_TIMEOUT 10000   // ms a locked access point gets before the lock is released
+
+// the network list of the portal comes from a background scan, repeated when the list is older than this (ms)
+#define WM_SCAN_MAX_AGE 30000
+
+// one network of the cached scan, the list is sorted strongest first with duplicate names removed
+struct WiFiScanEntry {
+  char    ssid[33];
+  int8_t  rssi;
+  boolean encrypted;
+};
+
 class WiFiManagerParameter {
   public:
     WiFiManagerParameter(const char *custom);
     WiFiManagerParameter(const char *id, const char *placeholder, const char *defaultValue, int length);
     WiFiManagerParameter(const char *id, const char *placeholder, const char *defaultValue, int length, const char *custom);
+    ~WiFiManagerParameter();
 
     const char *getID();
     const char *getValue();
     const char *getPlaceholder();
     int         getValueLength();
     const char *getCustomHTML();
+    //the submitted value was longer than the parameter, getValue() holds only the start of it
+    bool        isValueTruncated();
   private:
     const char *_id;
     const char *_placeholder;
     char       *_value;
     int         _length;
+    bool        _truncated;
     const char *_customHTML;
 
     void init(const char *id, const char *placeholder, const char *defaultValue, int length, const char *custom);
@@ -108,6 +150,11 @@ class WiFiManager
     void          setCustomHeadElement(const char* element);
     //if this is true, remove duplicated Access Points - defaut true
     void          setRemoveDuplicateAPs(boolean removeDuplicates);
+    //call from the sketch loop, watches the signal and roams to a stronger access point without blocking
+    void          roam();
+
+    //if this is true, reconnect straight to the last access point with the last ip lease, skipping scan and DHCP - default true
+    void          setFastConnect(boolean fastConnect);
 
   private:
     std::unique_ptr<DNSServer>        dnsServer;
@@ -120,6 +167,9 @@ class WiFiManager
 
     void          setupConfigPortal();
     void          startWPS();
+    void          startScan();
+    void          updateScan();
+    void          collectScan(int n);
 
     const char*   _apName                 = "no-net";
     const char*   _apPassword             = NULL;
@@ -136,11 +186,30 @@ class WiFiManager
     IPAddress     _sta_static_gw;
     IPAddress     _sta_static_sn;
 
+    std::unique_ptr<WiFiScanEntry[]> _scanResults;
+    int           _scanCount              = 0;
+    unsigned long _scanTime               = 0;
+    boolean       _scanDone               = false;
+
+    unsigned long _roamCheck              = 0;
+    unsigned long _roamScan               = 0;
+    boolean       _apLocked               = false; // station is locked onto one access point (bssid)
+    boolean       _apLockNew              = false; // not connected through the lock yet
+    unsigned long _apLockSeen             = 0;     // last time the locked access point was connected, or when the lock was set
+    uint8_t       _roamWeakSamples        = 0;
+    boolean       _roamScanning           = false;
+
+    boolean       _staticLease            = false; // connected with the cached lease as a static address, DHCP is off
+    unsigned long _staticLeaseSince       = 0;
+    volatile boolean _leaseBound          = false; // DHCP bound an address, the cache is refreshed from it
+    WiFiEventHandler _gotIpHandler;
+
     int           _paramsCount            = 0;
     int           _minimumQuality         = -1;
     boolean       _removeDuplicateAPs     = true;
     boolean       _shouldBreakAfterConfig = false;
     boolean       _tryWPS                 = false;
+    boolean       _fastConnect            = true;
 
     const char*   _customHeadElement      = "";
 
@@ -150,7 +219,15 @@ class WiFiManager
     int           status = WL_IDLE_STATUS;
     int           connectWifi(String ssid, String pass);
     uint8_t       waitForConnectResult();
-
+    boolean       fastConnect();
+    boolean       connectStrongest();
+    void          lockAccessPoint(const struct station_config& credentials, const uint8_t* bssid, uint8_t channel);
+    void          unlockAccessPoint();
+    void          storeFastConnect();
+    void          clearFastConnect();
+    void          serviceLease();
+
+    void          pageStart(WiFiManagerPage& page, const char* title);
     void          handleRoot();
     void          handleWifi(boolean scan);
     void          handleWifiSave();
@@ -0,0 +1,20 @@
+/*
+ Generated by tools/webassets.py from web/, do not edit by hand.
+
+ Stylesheet and script of the WiFiManager portal pages.
+ */
+
+#ifndef WiFiManagerAssets_h
+#define WiFiManagerAssets_h
+
+const char HTTP_STYLE[] PROGMEM  =
+  "<style>.c{text-align:center}div,input{padding:5px;font-size:1em}input{width:95%}body{text-align:cent"
+  "er;font-family:verdana}button{border:0;border-radius:0.3rem;background-color:#1fa3ec;color:#fff;line"
+  "-height:2.4rem;font-size:1.2rem;width:100%}.q{float:right;width:64px;text-align:right}.l{background:"
+  "url(\"/lock.png\") no-repeat left center;background-size:1em}</style>";
+
+const char HTTP_SCRIPT[] PROGMEM =
+  "<script>function c(l) {\ndocument.getElementById('s').value = l.innerText || l.textContent;\ndocumen"
+  "t.getElementById('p').focus();\n}</script>";
+
+#endif
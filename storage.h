@@ -0,0 +1,72 @@
+/***************************************************************************
+ Atomic file updates of the Salt sentry.
+
+ A file is replaced so that a power cut leaves either the old or the new
+ version, never a partial one: the data goes to <path>.tmp first and is
+ renamed over the original, which LittleFS does atomically. A power cut
+ before the rename leaves the temp file behind, it is removed at the next
+ boot. The functions are templates over the file system, the firmware uses
+ them with LittleFS, the host test with a RAM file system that loses power
+ at every step in turn.
+ ***************************************************************************/
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define STORAGE_PATH_SIZE 32        //LittleFS file names are at most 31 characters
+
+enum StorageResult : uint8_t {
+  STORAGE_OK,
+  STORAGE_PATH_TOO_LONG,
+  STORAGE_OPEN_FAILED,
+  STORAGE_WRITE_FAILED,             //file system full, the temp file is removed again
+  STORAGE_RENAME_FAILED
+};
+
+static const char* const storageResultNames[] = {
+  "ok", "path too long", "cannot open the temp file", "cannot write the temp file", "cannot rename the temp file"
+};
+
+inline bool tempPathFor(const char* path, char* tempPath, size_t size) {
+  return (size_t)snprintf(tempPath, size, "%s.tmp", path) < size;
+}
+
+template <typename FileSystem>
+StorageResult replaceFile(FileSystem& fs, const char* path, const uint8_t* data, size_t length) {
+  char tempPath[STORAGE_PATH_SIZE];
+  if (!tempPathFor(path, tempPath, sizeof(tempPath))) {
+    return STORAGE_PATH_TOO_LONG;
+  }
+
+  auto file = fs.open(tempPath, "w");
+  if (!file) {
+    return STORAGE_OPEN_FAILED;
+  }
+  size_t written = file.write(data, length);
+  file.close();
+
+  if (written != length) {
+    fs.remove(tempPath);
+    return STORAGE_WRITE_FAILED;
+  }
+  if (!fs.rename(tempPath, path)) {
+    return STORAGE_RENAME_FAILED;
+  }
+  return STORAGE_OK;
+}
+
+//Remove what an interrupted replaceFile left of path, the original is still intact. True when there was something
+template <typename FileSystem>
+bool removeTempFile(FileSystem& fs, const char* path) {
+  char tempPath[STORAGE_PATH_SIZE];
+  if (!tempPathFor(path, tempPath, sizeof(tempPath)) || !fs.exists(tempPath)) {
+    return false;
+  }
+  fs.remove(tempPath);
+  return true;
+}
+
+#endif
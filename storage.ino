@@ -0,0 +1,72 @@
+//File system: LittleFS mount, one time migration from SPIFFS and atomic file updates
+
+//Files carried over when an existing SPIFFS partition is converted to LittleFS,
+//also the files checked for unfinished atomic writes at boot
+const char* migratedFiles[] = { CONFIG_FILE, CONFIG_JSON_FILE };
+#define MIGRATE_MAX_FILE_SIZE 1024
+
+//Mount LittleFS, converting a SPIFFS partition written by older firmware on the first boot
+bool mountFileSystem() {
+  LittleFSConfig littleFsConfig;
+  littleFsConfig.setAutoFormat(false);
+  LittleFS.setConfig(littleFsConfig);
+  if (LittleFS.begin()) {
+    cleanupTempFiles();
+    return true;
+  }
+
+  LOG_WARN("no LittleFS found, converting the file system");
+
+  //SPIFFS and LittleFS share the partition, so the files have to be held in RAM while it is formatted
+  const size_t count = sizeof(migratedFiles) / sizeof(migratedFiles[0]);
+  std::unique_ptr<uint8_t[]> contents[count];
+  size_t lengths[count] = { 0 };
+
+  SPIFFSConfig spiffsConfig;
+  spiffsConfig.setAutoFormat(false);
+  SPIFFS.setConfig(spiffsConfig);
+  if (SPIFFS.begin()) {
+    for (size_t i = 0; i < count; i++) {
+      File file = SPIFFS.open(migratedFiles[i], "r");
+      if (file && file.size() <= MIGRATE_MAX_FILE_SIZE) {
+        lengths[i] = file.size();
+        contents[i].reset(new uint8_t[lengths[i]]);
+        file.read(contents[i].get(), lengths[i]);
+        LOG_INFO("read %s", migratedFiles[i]);
+      }
+    }
+    SPIFFS.end();
+  }
+
+  if (!LittleFS.format() || !LittleFS.begin()) {
+    LOG_ERROR("failed to format LittleFS");
+    return false;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (contents[i]) {
+      writeFileAtomic(migratedFiles[i], contents[i].get(), lengths[i]);
+    }
+  }
+  LOG_INFO("file system converted to LittleFS");
+  return true;
+}
+
+//Replace a file so that a power cut leaves either the old or the new version (see storage.h)
+bool writeFileAtomic(const char* path, const uint8_t* data, size_t length) {
+  StorageResult result = replaceFile(fileSystem, path, data, length);
+  if (result != STORAGE_OK) {
+    LOG_ERROR("failed to replace %s: %s", path, storageResultNames[result]);
+    return false;
+  }
+  return true;
+}
+
+//A power cut during writeFileAtomic can leave a temp file behind, the original is still intact
+void cleanupTempFiles() {
+  for (size_t i = 0; i < sizeof(migratedFiles) / sizeof(migratedFiles[0]); i++) {
+    if (removeTempFile(fileSystem, migratedFiles[i])) {
+      LOG_WARN("removed an unfinished write of %s", migratedFiles[i]);
+    }
+  }
+}
@@ -0,0 +1,234 @@
+//Micro benchmarks of the host compiled firmware code, with allocation counting.
+//Every benchmarked path runs on the device between measurements and is meant to be
+//allocation free, the run fails when one of them allocates. The times are host times,
+//useful to compare two versions of the code on the same machine, not device times
+
+#include <chrono>
+#include <new>
+
+#include "check.h"
+#include "bootprofile.h"
+#include "cbor.h"
+#include "config.h"
+#include "level.h"
+#include "page.h"
+#include "scheduler.h"
+#include "index.H"
+
+//Allocation counting: operator new always, malloc and friends when the linker wraps them
+//(ALLOC_WRAP_MALLOC, GNU ld), which only redirects the calls made from this program
+static size_t allocations = 0;
+
+#if ALLOC_WRAP_MALLOC
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+void* __wrap_malloc(size_t size) {
+  allocations++;
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  allocations++;
+  return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+  allocations++;
+  return __real_realloc(pointer, size);
+}
+}
+#endif
+
+void* operator new(size_t size) {
+  allocations++;
+#if ALLOC_WRAP_MALLOC
+  void* pointer = __real_malloc(size == 0 ? 1 : size);
+#else
+  void* pointer = malloc(size == 0 ? 1 : size);
+#endif
+  if (pointer == NULL) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  free(pointer);
+}
+
+//keeps the compiler from dropping a result that is never used
+template <typename T>
+static void keep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+template <typename Body>
+static void bench(const char* name, uint32_t iterations, Body body) {
+  body(0);                                //warm up, and allocations of the first call count too
+  allocations = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    body(i);
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  size_t allocated = allocations;
+
+  printf("%-22s %10.1f ns/op %8.2f allocs/op\n", name, ns / iterations, (double)allocated / iterations);
+  CHECK(allocated == 0);
+}
+
+static void noop() {
+}
+
+//the config page as handleRoot fills it in, sent to a sink that only counts
+static ConfigRecord pageConfig;
+static size_t pageBytes = 0;
+
+static void countPageBytes(const char* data, size_t length) {
+  keep(data);
+  pageBytes += length;
+}
+
+static void fillConfigPage(PageWriter& out, int n) {
+  char number[12];
+  switch (n) {
+    case PAGE_CONFIG_FORM: renderConfigForm(out, pageConfig); break;
+    case 6:  out.append("<div style=\"color:green;float:left\">connected</div>"); break;
+    case 11: out.append("0.1.9"); break;
+    case 12: out.append(dtostrf(57.3f, 1, 1, number)); break;
+    case 13: out.append(dtostrf(27.1f, 1, 1, number)); break;
+  }
+}
+
+int main() {
+  printf("%-22s %16s %18s\n", "benchmark", "time", "allocations");
+
+  bench("calculate_percentage", 10000000, [](uint32_t i) {
+    float percentage = calculatePercentage((float)(i % 600) / 10, 10, 50);
+    keep(percentage);
+  });
+
+  //the telemetry payloads of one measurement the firmware sends: binary record and plain text topics
+  bench("payload_cbor", 2000000, [](uint32_t i) {
+    uint8_t payload[48];
+    CborWriter cbor(payload, sizeof(payload));
+    encodeTelemetry(cbor, calculatePercentage((float)(i % 600) / 10, 10, 50), (float)(i % 600) / 10, 0, i);
+    keep(payload);
+  });
+
+  bench("payload_text", 2000000, [](uint32_t i) {
+    char percentage[8];
+    char distance[8];
+    dtostrf(calculatePercentage((float)(i % 600) / 10, 10, 50), 4, 1, percentage);
+    dtostrf((float)(i % 600) / 10, 4, 1, distance);
+    keep(percentage);
+    keep(distance);
+  });
+
+  //no firmware code: the same record as snprintf json, only the format comparison of the binary record.
+  //The json the firmware sends (/api, the _wifi topic) goes through ArduinoJson, which the host build lacks
+  bench("format_json", 2000000, [](uint32_t i) {
+    char payload[96];
+    snprintf(payload, sizeof(payload), "{\"v\":1,\"pct\":%.1f,\"cm\":%.1f,\"st\":0,\"up\":%u}",
+             calculatePercentage((float)(i % 600) / 10, 10, 50), (float)(i % 600) / 10, i);
+    keep(payload);
+  });
+
+  //boot: the record is read from flash (a copy here) and checked
+  static ConfigRecord stored;
+  memset(&stored, 0, sizeof(stored));
+  for (size_t f = 0; f < CONFIG_FIELD_COUNT; f++) {
+    strncpy(configValue(stored, configFields[f]), "12", configFields[f].size - 1);
+  }
+  configSeal(stored);
+  memcpy(&pageConfig, &stored, sizeof(pageConfig));
+
+  bench("config_load", 200000, [](uint32_t) {
+    ConfigRecord config;
+    memcpy(&config, &stored, sizeof(config));
+    bool valid = configValid(config);
+    keep(valid);
+  });
+
+  //a record written by firmware without the last field
+  const size_t oldSize = offsetof(ConfigRecord, ota_url) + sizeof(uint32_t);
+  static ConfigRecord old;
+  memcpy(&old, &stored, sizeof(old));
+  old.size = oldSize;
+  uint32_t oldCrc = configCrc(&old, oldSize - sizeof(uint32_t));
+  memcpy((uint8_t*)&old + oldSize - sizeof(uint32_t), &oldCrc, sizeof(oldCrc));
+
+  bench("config_upgrade", 200000, [oldSize](uint32_t) {
+    ConfigRecord config;
+    memcpy(&config, &old, sizeof(config));
+    bool upgraded = configUpgrade(config, oldSize);
+    keep(upgraded);
+  });
+
+  bench("config_validate", 1000000, [](uint32_t) {
+    bool valid = true;
+    for (size_t f = 0; f < CONFIG_FIELD_COUNT; f++) {
+      valid &= configValueValid(configFields[f], configValue(stored, configFields[f]));
+    }
+    keep(valid);
+  });
+
+  //the task set of the firmware, one slice per simulated ms
+  static Scheduler scheduler;
+  static Task tasks[13];
+  static const uint32_t intervals[13] = { 20, 10, 10, 10, 50, 1000, 1000, 1000, 1000, 60000, 100, 10, 5000 };
+  for (int t = 0; t < 13; t++) {
+    tasks[t] = { "task", noop, PRIORITY_NORMAL };
+    scheduler.every(tasks[t], intervals[t], t);
+  }
+
+  bench("scheduler_slice", 2000000, [](uint32_t) {
+    hostClockUs += 1000;
+    uint32_t idle = scheduler.runSlice(2000);
+    keep(idle);
+  });
+
+  static BootProfile boot = { };
+  for (int phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+    boot.mark((BootPhase)phase, 100000 * (phase + 1));
+  }
+
+  bench("boot_report", 1000000, [](uint32_t) {
+    char report[320];
+    size_t length = boot.report(report, sizeof(report));
+    keep(length);
+  });
+
+  //GET /: the config page template with the form of the stored record, into a sink that only counts
+  bench("config_page", 200000, [](uint32_t) {
+    PageWriter out(countPageBytes);
+    renderPage(out, config_page, config_page_slots, CONFIG_PAGE_SLOTS, fillConfigPage);
+  });
+
+  //one render is the whole template with the values and the form in it
+  pageBytes = 0;
+  PageWriter out(countPageBytes);
+  renderPage(out, config_page, config_page_slots, CONFIG_PAGE_SLOTS, fillConfigPage);
+  CHECK(pageBytes > strlen_P(config_page) + CONFIG_FIELD_COUNT * 40);
+
+  return checkResult();
+}
@@ -0,0 +1,73 @@
+//Host harness of the boot profiler (bootprofile.h): setup() is replayed on the simulated
+//clock with typical phase latencies, for a power-on and for a wakeup from deep sleep, and
+//the breakdown is printed the way reportBootProfile logs it, followed by the /api/boot json
+
+#include "check.h"
+#include "bootprofile.h"
+#include "Arduino.h"
+
+//simulated time (ms) spent in every phase, in the order setup() and loop() run them
+struct BootScenario {
+  const char* name;
+  uint32_t phaseMs[BOOT_PHASE_COUNT];
+};
+
+static const BootScenario scenarios[] = {
+  //serial, fs mount, config load, wifi (DHCP), web server, config save, mqtt, sensor, measurement, publish
+  { "power-on", { 65, 180, 4, 2400, 6, 45, 1, 55, 35, 120 } },
+  //config from RTC memory, fast reconnect from the RTC cache, nothing to save
+  { "deep sleep wakeup", { 65, 180, 1, 280, 6, 0, 1, 55, 35, 120 } },
+  //no config, the portal waits for the user (here 90 s)
+  { "first boot", { 65, 900, 2, 90000, 6, 60, 1, 55, 35, 150 } },
+};
+
+static void replay(BootProfile& profile, const BootScenario& scenario) {
+  hostClockUs = 0;
+  memset(&profile, 0, sizeof(profile));
+  for (int phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+    delay(scenario.phaseMs[phase]);
+    profile.mark((BootPhase)phase, micros());
+    profile.mark((BootPhase)phase, micros() + 1000);    //a second mark of a phase is ignored
+  }
+}
+
+int main() {
+  for (const BootScenario& scenario : scenarios) {
+    BootProfile profile;
+    replay(profile, scenario);
+
+    printf("%s, boot phases (ms):\n", scenario.name);
+    uint32_t totalMs = 0;
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+      printf("  %-18s %8.1f\n", bootPhaseNames[i], profile.durationUs(i) / 1000.0);
+      CHECK(profile.durationUs(i) == scenario.phaseMs[i] * 1000);
+      totalMs += scenario.phaseMs[i];
+    }
+    printf("  %-18s %8.1f\n", "total", profile.markUs[BOOT_PHASE_COUNT - 1] / 1000.0);
+    CHECK(profile.complete());
+    CHECK(profile.markUs[BOOT_PHASE_COUNT - 1] == totalMs * 1000);
+
+    char report[320];
+    size_t length = profile.report(report, sizeof(report));
+    printf("  %s\n\n", report);
+    CHECK(length == strlen(report));
+    CHECK(report[0] == '{' && report[length - 1] == '}');
+  }
+
+  //an unfinished boot reports the phases that ended so far, the others as 0
+  BootProfile partial = { };
+  partial.mark(BOOT_SERIAL, 65000);
+  partial.mark(BOOT_FS_MOUNT, 245000);
+  CHECK(!partial.complete());
+  CHECK(partial.durationUs(BOOT_FS_MOUNT) == 180000);
+  CHECK(partial.durationUs(BOOT_CONFIG_LOAD) == 0);
+
+  //a buffer that is too small is cut off, never overrun
+  char small[40];
+  memset(small, 'x', sizeof(small));
+  size_t length = partial.report(small, 32);
+  CHECK(length == 31);
+  CHECK(small[31] == '\0' && small[32] == 'x');
+
+  return checkResult();
+}
@@ -0,0 +1,179 @@
+//Host test of the CBOR writer (cbor.h): the encoding examples of RFC 8949 appendix A,
+//overflow, and a decode of the telemetry record. The encode times against the dtostrf
+//and JSON payloads are in the bench (payload_cbor, payload_text, format_json)
+
+#include "check.h"
+#include "cbor.h"
+#include "Arduino.h"
+
+template <typename Write>
+static bool encodes(Write write, const char* expected) {
+  uint8_t buffer[16];
+  CborWriter cbor(buffer, sizeof(buffer));
+  write(cbor);
+  char hex[2 * sizeof(buffer) + 1] = "";
+  for (size_t i = 0; i < cbor.length(); i++) {
+    sprintf(hex + 2 * i, "%02x", buffer[i]);
+  }
+  if (!cbor.ok() || strcmp(hex, expected) != 0) {
+    printf("encoded %s, expected %s\n", hex, expected);
+    return false;
+  }
+  return true;
+}
+
+#define CHECK_ENCODES(call, expected) CHECK(encodes([](CborWriter& cbor) { cbor.call; }, expected))
+
+//Decoder for the items the writer produces, enough to read the telemetry record back
+class CborReader {
+  public:
+    CborReader(const uint8_t* data, size_t length) : _data(data), _length(length), _position(0), _error(false) {}
+
+    uint32_t map() {
+      return head(5);
+    }
+
+    bool text(char* value, size_t size) {
+      uint32_t length = head(3);
+      if (_error || length >= size || _position + length > _length) {
+        _error = true;
+        return false;
+      }
+      memcpy(value, _data + _position, length);
+      value[length] = '\0';
+      _position += length;
+      return true;
+    }
+
+    //an integer of either sign, or a single precision float
+    double number() {
+      uint8_t major = peek() >> 5;
+      if (peek() == 0xFA) {
+        _position++;
+        uint32_t bits = (uint32_t)get() << 24;
+        bits |= (uint32_t)get() << 16;
+        bits |= (uint32_t)get() << 8;
+        bits |= get();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+      if (major == 1) {
+        return -1.0 - head(1);
+      }
+      return head(0);
+    }
+
+    bool done() const {
+      return !_error && _position == _length;
+    }
+
+  private:
+    const uint8_t* _data;
+    size_t _length;
+    size_t _position;
+    bool _error;
+
+    uint8_t peek() {
+      if (_position >= _length) {
+        _error = true;
+        return 0;
+      }
+      return _data[_position];
+    }
+
+    uint8_t get() {
+      uint8_t value = peek();
+      _position++;
+      return value;
+    }
+
+    uint32_t head(uint8_t major) {
+      uint8_t initial = get();
+      if (initial >> 5 != major) {
+        _error = true;
+        return 0;
+      }
+      uint8_t info = initial & 0x1F;
+      if (info < 24) {
+        return info;
+      }
+      int bytes = info == 24 ? 1 : info == 25 ? 2 : info == 26 ? 4 : 0;
+      if (bytes == 0) {
+        _error = true;
+        return 0;
+      }
+      uint32_t value = 0;
+      while (bytes-- > 0) {
+        value = value << 8 | get();
+      }
+      return value;
+    }
+};
+
+int main() {
+  //RFC 8949 appendix A
+  CHECK_ENCODES(number((uint32_t)0), "00");
+  CHECK_ENCODES(number((uint32_t)10), "0a");
+  CHECK_ENCODES(number((uint32_t)23), "17");
+  CHECK_ENCODES(number((uint32_t)24), "1818");
+  CHECK_ENCODES(number((uint32_t)100), "1864");
+  CHECK_ENCODES(number((uint32_t)1000), "1903e8");
+  CHECK_ENCODES(number((uint32_t)1000000), "1a000f4240");
+  CHECK_ENCODES(number((int32_t)-1), "20");
+  CHECK_ENCODES(number((int32_t)-10), "29");
+  CHECK_ENCODES(number((int32_t)-100), "3863");
+  CHECK_ENCODES(number((int32_t)-1000), "3903e7");
+  CHECK_ENCODES(number(100000.0f), "fa47c35000");
+  CHECK_ENCODES(number(3.4028234663852886e+38f), "fa7f7fffff");
+  CHECK_ENCODES(text(""), "60");
+  CHECK_ENCODES(text("a"), "6161");
+  CHECK_ENCODES(text("IETF"), "6449455446");
+  CHECK_ENCODES(text("\"\\"), "62225c");
+  CHECK_ENCODES(text("ü"), "62c3bc");
+  CHECK_ENCODES(map(0), "a0");
+  CHECK_ENCODES(number((uint32_t)0xFFFFFFFF), "1affffffff");
+  CHECK_ENCODES(number((int32_t)INT32_MIN), "3a7fffffff");
+
+  //a buffer that is too small is never overrun and the record is flagged
+  uint8_t small[6] = { 0, 0, 0, 0, 0xAA, 0xAA };
+  CborWriter truncated(small, 4);
+  truncated.text("IETF");
+  CHECK(!truncated.ok());
+  CHECK(truncated.length() == 4);
+  CHECK(small[4] == 0xAA);
+
+  //the telemetry record decodes to what was encoded, in the order the consumers expect
+  uint8_t payload[48];
+  CborWriter cbor(payload, sizeof(payload));
+  encodeTelemetry(cbor, 57.3f, 27.1f, 4, 86400 * 30);
+  CHECK(cbor.ok());
+
+  CborReader reader(payload, cbor.length());
+  const char* keys[] = { "v", "pct", "cm", "st", "up" };
+  const double values[] = { TELEMETRY_SCHEMA_VERSION, 57.3f, 27.1f, 4, 86400 * 30 };
+  CHECK(reader.map() == 5);
+  for (int i = 0; i < 5; i++) {
+    char key[8];
+    CHECK(reader.text(key, sizeof(key)) && strcmp(key, keys[i]) == 0);
+    CHECK(reader.number() == values[i]);
+  }
+  CHECK(reader.done());
+
+  //the worst case fits the 48 byte buffer of sendMqttBinaryMessage
+  CborWriter worst(payload, sizeof(payload));
+  encodeTelemetry(worst, -1e30f, 1e30f, 255, 0xFFFFFFFF);
+  CHECK(worst.ok());
+
+  //sizes of one measurement in the three formats
+  char text[2][8];
+  dtostrf(57.3f, 4, 1, text[0]);
+  dtostrf(27.1f, 4, 1, text[1]);
+  char json[96];
+  int jsonLength = snprintf(json, sizeof(json), "{\"v\":1,\"pct\":%.1f,\"cm\":%.1f,\"st\":4,\"up\":%u}", 57.3f, 27.1f, 86400 * 30);
+  printf("payload bytes: cbor %u, text %u (two topics), json %d\n",
+         (unsigned)cbor.length(), (unsigned)(strlen(text[0]) + strlen(text[1])), jsonLength);
+  printf("cbor bytes, worst case: %u of %u\n", (unsigned)worst.length(), (unsigned)sizeof(payload));
+
+  return checkResult();
+}
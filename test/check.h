@@ -0,0 +1,30 @@
+/***************************************************************************
+ Assertions of the host tests. A failed CHECK prints the expression and the
+ line and the test goes on, main() returns checkResult() so ctest sees the
+ failure.
+ ***************************************************************************/
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+inline int checkFailures = 0;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+inline int checkResult() {
+  if (checkFailures != 0) {
+    printf("%d checks failed\n", checkFailures);
+    return 1;
+  }
+  printf("all checks passed\n");
+  return 0;
+}
+
+#endif
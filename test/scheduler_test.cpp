@@ -0,0 +1,169 @@
+//Host test of the task scheduler (scheduler.h) on the simulated clock of stubs/Arduino.h
+
+#include "check.h"
+#include "scheduler.h"
+
+static Scheduler* scheduler;
+static uint32_t maxLateMs;             //longest a run started after its due time
+
+static void late(const Task& task) {
+  uint32_t lateMs = millis() - task.due;
+  if (lateMs > maxLateMs) {
+    maxLateMs = lateMs;
+  }
+}
+
+static Task fast, slow, blocking, high, low;
+static uint32_t order[4];
+static uint32_t orderCount;
+
+static void runFast() {
+  late(fast);
+}
+
+static void runSlow() {
+  late(slow);
+}
+
+static void runBlocking() {
+  late(blocking);
+  delay(13);
+}
+
+static void runHigh() {
+  order[orderCount++] = PRIORITY_HIGH;
+}
+
+static void runLow() {
+  order[orderCount++] = PRIORITY_LOW;
+}
+
+static void reset(uint64_t startMs) {
+  static Scheduler instance;
+  instance = Scheduler();
+  scheduler = &instance;
+  hostClockUs = startMs * 1000;
+  maxLateMs = 0;
+  fast = { "fast", runFast, PRIORITY_NORMAL };
+  slow = { "slow", runSlow, PRIORITY_NORMAL };
+  blocking = { "blocking", runBlocking, PRIORITY_NORMAL };
+  high = { "high", runHigh, PRIORITY_HIGH };
+  low = { "low", runLow, PRIORITY_LOW };
+  orderCount = 0;
+}
+
+//the main loop: a slice, then sleep as long as runSlice says nothing is due
+static void runUntil(uint64_t endMs) {
+  while (hostClockUs < endMs * 1000) {
+    uint32_t idle = scheduler->runSlice(5000);
+    delay(idle == 0 ? 1 : idle);
+  }
+}
+
+//a loop that polls every ms, without sleeping
+static void pollUntil(uint64_t endMs) {
+  while (hostClockUs < endMs * 1000) {
+    scheduler->runSlice(5000);
+    delay(1);
+  }
+}
+
+int main() {
+  //a task due inside a tick that was collected before it was due used to wait a whole wheel round
+  reset(1001);
+  scheduler->runSlice(5000);
+  scheduler->once(fast, 7);             //due at 1008, inside the tick 1000-1009
+  hostClockUs = 1005 * 1000;
+  scheduler->runSlice(5000);
+  CHECK(fast.runs == 0);
+  hostClockUs = 1008 * 1000;
+  scheduler->runSlice(5000);
+  hostClockUs = 1010 * 1000;
+  scheduler->runSlice(5000);
+  CHECK(fast.runs == 1);
+
+  //periodic tasks whose period is not a multiple of the tick, polled and sleeping
+  reset(5003);
+  scheduler->every(fast, 25, 3);
+  scheduler->every(slow, 333, 0);
+  pollUntil(6011);
+  CHECK(fast.runs == 41);             //due at 5006 to 6006
+  CHECK(slow.runs == 4);              //due at 5003 to 6002
+  CHECK(maxLateMs < SCHEDULER_TICK_MS);
+
+  reset(5003);
+  scheduler->every(fast, 25, 3);
+  scheduler->every(slow, 333, 0);
+  runUntil(6011);
+  CHECK(fast.runs == 41);
+  CHECK(slow.runs == 4);
+  CHECK(maxLateMs < SCHEDULER_TICK_MS);
+
+  //a task that blocks for 13 ms holds up the others, the run of the 10 ms task that it covers
+  //is skipped (4 of 5 remain) and none falls a wheel round behind
+  reset(0);
+  scheduler->every(fast, 10, 0);
+  scheduler->every(blocking, 50, 5);
+  runUntil(55000);
+  CHECK(blocking.runs >= 1099 && blocking.runs <= 1100);
+  CHECK(fast.runs >= 4399 && fast.runs <= 4400);
+  CHECK(maxLateMs < 13 + SCHEDULER_TICK_MS);
+
+  //the idle time never oversleeps a due task
+  reset(7);
+  scheduler->every(fast, 17, 1);
+  scheduler->every(slow, 1000, 999);
+  runUntil(10011);
+  CHECK(fast.runs == 589);            //due at 8 to 10004
+  CHECK(slow.runs == 10);             //due at 1006 to 10006
+  CHECK(maxLateMs < SCHEDULER_TICK_MS);
+
+  //tasks due together run by priority
+  reset(100);
+  scheduler->once(low, 20);
+  scheduler->once(high, 20);
+  runUntil(200);
+  CHECK(orderCount == 2);
+  CHECK(order[0] == PRIORITY_HIGH && order[1] == PRIORITY_LOW);
+
+  //millis() wraps after 49 days, tasks keep their rhythm across it and nothing runs early
+  reset(0xFFFFFFFFULL - 300);
+  scheduler->every(fast, 10, 0);
+  scheduler->every(slow, 100, 50);
+  runUntil(0xFFFFFFFFULL + 700);
+  CHECK(fast.runs >= 99 && fast.runs <= 101);
+  CHECK(slow.runs == 10);
+  CHECK(maxLateMs < SCHEDULER_TICK_MS);
+
+  //cancel and rescheduling an armed task
+  reset(300);
+  scheduler->every(fast, 10, 0);
+  runUntil(350);
+  uint32_t runs = fast.runs;
+  scheduler->cancel(fast);
+  runUntil(450);
+  CHECK(fast.runs == runs);
+  scheduler->once(fast, 500);
+  scheduler->once(fast, 5);
+  runUntil(1500);
+  CHECK(fast.runs == runs + 1);
+
+  //a full statistics table is reported, the tasks that do not fit still run
+  reset(0);
+  static Task many[SCHEDULER_MAX_TASKS + 1];
+  for (Task& task : many) {
+    task.run = runFast;
+  }
+  for (size_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+    CHECK(scheduler->track(many[i]));
+  }
+  CHECK(!scheduler->overflow);
+  CHECK(!scheduler->track(many[SCHEDULER_MAX_TASKS]));
+  CHECK(scheduler->overflow);
+  CHECK(scheduler->taskCount() == SCHEDULER_MAX_TASKS);
+  scheduler->once(many[SCHEDULER_MAX_TASKS], 5);
+  runUntil(100);
+  CHECK(many[SCHEDULER_MAX_TASKS].runs == 1);
+
+  return checkResult();
+}
@@ -0,0 +1,193 @@
+//Host test of the atomic file updates (storage.h) on a RAM file system that loses power
+//at every step of the temp file and rename sequence in turn, and during the write after
+//every byte. After every power cut the boot cleanup runs, and the file must hold the old
+//or the new contents, never a mix
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "storage.h"
+
+struct PowerCut { };
+
+class RamFile;
+
+class RamFileSystem {
+  public:
+    std::map<std::string, std::vector<uint8_t>> files;
+    int stepsLeft = -1;                 //changes until the power is cut, -1 for never
+    size_t cutBytes = 0;                //bytes of a write the power cut interrupts that reach the file
+    bool cutInWrite = false;
+    size_t capacity = 4096;             //bytes of all files together
+    bool openFails = false;
+
+    RamFile open(const char* path, const char* mode);
+
+    bool exists(const char* path) {
+      return files.count(path) != 0;
+    }
+
+    bool remove(const char* path) {
+      step();
+      return files.erase(path) != 0;
+    }
+
+    //replaces an existing file in one step, like LittleFS
+    bool rename(const char* from, const char* to) {
+      step();
+      auto file = files.find(from);
+      if (file == files.end()) {
+        return false;
+      }
+      std::vector<uint8_t> data = file->second;
+      files.erase(file);
+      files[to] = data;
+      return true;
+    }
+
+    size_t used() const {
+      size_t bytes = 0;
+      for (const auto& file : files) {
+        bytes += file.second.size();
+      }
+      return bytes;
+    }
+
+    void step() {
+      if (stepsLeft >= 0 && stepsLeft-- == 0) {
+        throw PowerCut();
+      }
+    }
+};
+
+class RamFile {
+  public:
+    RamFile(RamFileSystem* fs, const std::string& path) : _fs(fs), _path(path) {}
+
+    explicit operator bool() const {
+      return _fs != nullptr;
+    }
+
+    //a power cut during a write leaves the first cutBytes of it in the file
+    size_t write(const uint8_t* data, size_t length) {
+      size_t room = _fs->capacity - _fs->used();
+      size_t count = length < room ? length : room;
+      std::vector<uint8_t>& contents = _fs->files[_path];
+      if (_fs->stepsLeft == 0) {
+        contents.insert(contents.end(), data, data + (_fs->cutBytes < count ? _fs->cutBytes : count));
+        _fs->cutInWrite = true;
+      }
+      _fs->step();
+      contents.insert(contents.end(), data, data + count);
+      return count;
+    }
+
+    void close() {
+      _fs->step();
+    }
+
+  private:
+    RamFileSystem* _fs;
+    std::string _path;
+};
+
+RamFile RamFileSystem::open(const char* path, const char* mode) {
+  step();
+  if (openFails || std::string(mode) != "w") {
+    return RamFile(nullptr, path);
+  }
+  files[path].clear();                //created, or truncated, right away
+  return RamFile(this, path);
+}
+
+static const char* path = "/config.bin";
+static const std::vector<uint8_t> oldContents(316, 0x11);
+static const std::vector<uint8_t> newContents(316, 0x22);
+
+//One update with the power cut at step cutAt, then a reboot. The file must be intact.
+//Returns false when the update finished before the power cut
+static bool updateWithPowerCut(bool previous, int cutAt, size_t cutBytes, bool& cutInWrite) {
+  RamFileSystem fs;
+  if (previous) {
+    fs.files[path] = oldContents;
+  }
+  fs.stepsLeft = cutAt;
+  fs.cutBytes = cutBytes;
+  bool cut = false;
+  StorageResult result = STORAGE_OK;
+  try {
+    result = replaceFile(fs, path, newContents.data(), newContents.size());
+  } catch (PowerCut&) {
+    cut = true;
+  }
+  cutInWrite = fs.cutInWrite;
+
+  //reboot
+  fs.stepsLeft = -1;
+  removeTempFile(fs, path);
+  CHECK(!fs.exists("/config.bin.tmp"));
+  CHECK(fs.files.size() <= 1);
+
+  if (!cut) {
+    CHECK(result == STORAGE_OK);
+    CHECK(fs.exists(path) && fs.files[path] == newContents);
+  } else if (fs.exists(path)) {
+    CHECK(fs.files[path] == newContents || (previous && fs.files[path] == oldContents));
+  } else {
+    CHECK(!previous);
+  }
+  return cut;
+}
+
+//a power cut at every step of one update, and during the write after every byte,
+//with and without a previous version of the file
+static void powerCutAtEveryStep(bool previous) {
+  int interrupted = 0;
+  size_t writeCuts = 0;
+  for (int cutAt = 0; ; cutAt++) {
+    bool cutInWrite;
+    if (!updateWithPowerCut(previous, cutAt, 0, cutInWrite)) {
+      break;
+    }
+    interrupted++;
+    for (size_t bytes = 1; cutInWrite && bytes <= newContents.size(); bytes++) {
+      updateWithPowerCut(previous, cutAt, bytes, cutInWrite);
+      writeCuts++;
+    }
+  }
+  CHECK(interrupted == 4);            //open, write, close, rename
+  CHECK(writeCuts == newContents.size());
+}
+
+int main() {
+  powerCutAtEveryStep(true);
+  powerCutAtEveryStep(false);
+
+  //a full file system keeps the old version and does not leave a partial temp file
+  RamFileSystem full;
+  full.files[path] = oldContents;
+  full.capacity = oldContents.size() + newContents.size() / 2;
+  CHECK(replaceFile(full, path, newContents.data(), newContents.size()) == STORAGE_WRITE_FAILED);
+  CHECK(full.files[path] == oldContents);
+  CHECK(!full.exists("/config.bin.tmp"));
+
+  RamFileSystem broken;
+  broken.files[path] = oldContents;
+  broken.openFails = true;
+  CHECK(replaceFile(broken, path, newContents.data(), newContents.size()) == STORAGE_OPEN_FAILED);
+  CHECK(broken.files[path] == oldContents);
+
+  //the temp name has to fit, a cut off name could collide with another file
+  RamFileSystem fs;
+  CHECK(replaceFile(fs, "/a_file_name_of_28_chars.bin", newContents.data(), newContents.size()) == STORAGE_PATH_TOO_LONG);
+  CHECK(fs.files.empty());
+
+  //the cleanup leaves files without a temp file alone
+  fs.files[path] = oldContents;
+  CHECK(!removeTempFile(fs, path));
+  CHECK(fs.files[path] == oldContents);
+
+  return checkResult();
+}
@@ -0,0 +1,55 @@
+/***************************************************************************
+ Just enough of the ESP8266 Arduino core for the host build of the headers.
+
+ The clock is simulated: millis() and micros() read hostClockUs, which only
+ moves when a test advances it (delay() does too), so timing tests are exact
+ and take no real time. millis() is derived from the 64 bit count, so it
+ wraps after 49 days like on the device and micros() after 71 minutes.
+ ***************************************************************************/
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+inline uint64_t hostClockUs = 0;
+
+inline uint32_t micros() {
+  return (uint32_t)hostClockUs;
+}
+
+inline uint32_t millis() {
+  return (uint32_t)(hostClockUs / 1000);
+}
+
+inline void delay(uint32_t ms) {
+  hostClockUs += (uint64_t)ms * 1000;
+}
+
+//flash is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+typedef const char* PGM_P;
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+//the float formatting of the core (stdlib_noniso)
+inline char* dtostrf(double value, signed char width, unsigned char precision, char* buffer) {
+  sprintf(buffer, "%*.*f", width, precision, value);
+  return buffer;
+}
+
+class EspClass {
+  public:
+    uint32_t getCycleCount() {
+      return (uint32_t)(hostClockUs * 80);
+    }
+};
+
+inline EspClass ESP;
+
+#endif
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Local firmware update server for testing the Salt sentry OTA updates.
+
+Serves a firmware image the way the device expects it from a real update
+server:
+
+  /manifest.json     {"version", "url", "size", "md5"} of the image
+  /firmware.bin.gz   the image, gzipped (or /firmware.bin with --no-gzip),
+                     with support for single range requests
+
+Export the binary from the Arduino IDE (Sketch > Export compiled binary),
+then run from the repository root:
+
+  python3 tools/ota_server.py SaltSentry.ino.generic.bin --version 0.2.0
+
+and set the update manifest url on the config page to the printed url.
+POST /api/ota on the device checks right away instead of waiting for the
+next periodic check.
+
+--interrupt cuts off that fraction of the image responses halfway, to
+exercise the resumed download. Only the Python standard library is needed.
+"""
+
+import argparse
+import gzip
+import hashlib
+import http.server
+import json
+import random
+import re
+import socket
+import sys
+
+RANGE = re.compile(r'bytes=(\d+)-(\d*)$')
+
+
+def load_image(path, compress):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:1] != b'\xe9':
+        sys.exit('%s does not look like an ESP8266 firmware image' % path)
+    if compress:
+        # the bootloader inflates the image, the device stores it as it is sent
+        data = gzip.compress(data, 9, mtime=0)
+    return data
+
+
+def make_handler(image, image_path, version, interrupt):
+    md5 = hashlib.md5(image).hexdigest()
+
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = 'HTTP/1.1'     # keep-alive, the device reuses the connection between ranges
+
+        def send_body(self, code, content_type, body, extra_headers=()):
+            self.send_response(code)
+            self.send_header('Content-Type', content_type)
+            self.send_header('Content-Length', str(len(body)))
+            for name, value in extra_headers:
+                self.send_header(name, value)
+            self.end_headers()
+            if self.command == 'HEAD':
+                return
+            if code == 206 and random.random() < interrupt:
+                self.wfile.write(body[:len(body) // 2])
+                self.close_connection = True
+                self.log_message('interrupted the response halfway')
+                return
+            self.wfile.write(body)
+
+        def do_GET(self):
+            if self.path == '/manifest.json':
+                host = self.headers.get('Host') or '%s:%d' % self.server.server_address
+                manifest = {'version': version, 'url': 'http://%s%s' % (host, image_path),
+                            'size': len(image), 'md5': md5}
+                self.send_body(200, 'application/json', json.dumps(manifest).encode())
+            elif self.path == image_path:
+                self.send_image()
+            else:
+                self.send_body(404, 'text/plain', b'not found\n')
+
+        do_HEAD = do_GET
+
+        def send_image(self):
+            header = self.headers.get('Range')
+            if header is None:
+                self.send_body(200, 'application/octet-stream', image, [('Accept-Ranges', 'bytes')])
+                return
+            match = RANGE.match(header.strip())
+            start = int(match.group(1)) if match else len(image)
+            end = min(int(match.group(2)) if match and match.group(2) else len(image) - 1, len(image) - 1)
+            if start > end:
+                self.send_body(416, 'text/plain', b'range not satisfiable\n', [('Content-Range', 'bytes */%d' % len(image))])
+                return
+            self.send_body(206, 'application/octet-stream', image[start:end + 1],
+                           [('Content-Range', 'bytes %d-%d/%d' % (start, end, len(image)))])
+
+    return Handler, md5
+
+
+def local_address():
+    # the address other hosts on the network reach this machine on, nothing is sent
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as s:
+        try:
+            s.connect(('10.255.255.255', 1))
+            return s.getsockname()[0]
+        except OSError:
+            return '127.0.0.1'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Local firmware update server for the Salt sentry.')
+    parser.add_argument('image', help='firmware binary exported from the Arduino IDE')
+    parser.add_argument('--version', required=True, help='version announced in the manifest, e.g. 0.2.0')
+    parser.add_argument('--port', type=int, default=8266)
+    parser.add_argument('--no-gzip', action='store_true', help='serve the image uncompressed')
+    parser.add_argument('--interrupt', type=float, default=0.0, metavar='FRACTION',
+                        help='fraction of the image responses to cut off halfway (0 to 1)')
+    args = parser.parse_args()
+
+    image = load_image(args.image, not args.no_gzip)
+    image_path = '/firmware.bin' if args.no_gzip else '/firmware.bin.gz'
+    handler, md5 = make_handler(image, image_path, args.version, args.interrupt)
+
+    server = http.server.ThreadingHTTPServer(('', args.port), handler)
+    print('serving %s as version %s: %d bytes%s, md5 %s' % (args.image, args.version, len(image),
+          '' if args.no_gzip else ' gzipped', md5))
+    print('update manifest url: http://%s:%d/manifest.json' % (local_address(), args.port))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
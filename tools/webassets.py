@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""
+Web asset pipeline for the Salt sentry firmware.
+
+Takes the sources in web/ and generates the PROGMEM headers the firmware
+serves from:
+
+  index.H                    config page template, minified, with a table of
+                             placeholder offsets so rendering never searches
+  src/StaticAssetsData.h     logo and icons, metadata stripped and gzipped
+                             when that makes them smaller
+  src/WiFiManagerAssets.h    stylesheet and script of the WiFiManager portal
+
+Run it from the repository root after changing anything in web/:
+
+  python3 tools/webassets.py
+
+Only the Python standard library is needed. Output is deterministic (gzip
+mtime is fixed), so regenerating without source changes gives no diff.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+WEB = os.path.join(ROOT, 'web')
+
+# (url, source file, content type)
+STATIC_ASSETS = [
+    ('/logo.jpg', 'logo.jpg', 'image/jpeg'),
+    ('/lock.png', 'lock.png', 'image/png'),
+]
+
+PLACEHOLDER = re.compile(r'\{(\d{1,2})\}')
+
+GENERATED_NOTE = 'Generated by tools/webassets.py from web/, do not edit by hand.'
+
+
+def read(name, mode='r'):
+    with open(os.path.join(WEB, name), mode) as f:
+        return f.read()
+
+
+def write(path, text):
+    with open(os.path.join(ROOT, path), 'w', newline='\n') as f:
+        f.write(text)
+
+
+# ---------------------------------------------------------------- minifiers
+
+def minify_css(css):
+    css = re.sub(r'/\*.*?\*/', '', css, flags=re.S)
+    css = re.sub(r'\s+', ' ', css)
+    css = re.sub(r'\s*([{}:;,])\s*', r'\1', css)
+    css = css.replace(';}', '}')
+    return css.strip()
+
+
+def minify_js(js):
+    # deliberately conservative: drop comment lines and indentation, keep line breaks
+    lines = []
+    for line in js.splitlines():
+        line = line.strip()
+        if line and not line.startswith('//'):
+            lines.append(line)
+    return '\n'.join(lines)
+
+
+def minify_html(html):
+    html = re.sub(r'<!--.*?-->', '', html, flags=re.S)
+
+    def block(match):
+        tag, attrs, body = match.group(1), match.group(2), match.group(3)
+        body = minify_css(body) if tag == 'style' else minify_js(body)
+        return '<%s%s>%s</%s>' % (tag, attrs, body, tag)
+
+    parts = re.split(r'(<(style|script)([^>]*)>(.*?)</\2>)', html, flags=re.S)
+    out = []
+    i = 0
+    while i < len(parts):
+        text = parts[i]
+        # whitespace with a line break next to a tag is layout only, elsewhere it is one space
+        text = re.sub(r'>\s*\n\s*', '>', text)
+        text = re.sub(r'\s*\n\s*<', '<', text)
+        text = re.sub(r'\s+', ' ', text)
+        out.append(text)
+        if i + 1 < len(parts):
+            out.append(block(re.match(r'<(style|script)([^>]*)>(.*?)</\1>', parts[i + 1], flags=re.S)))
+        i += 5
+    return ''.join(out).strip()
+
+
+def strip_jpeg(data):
+    """Drop EXIF/XMP/IPTC/comment segments, they are not needed to display the image."""
+    if data[:2] != b'\xff\xd8':
+        return data
+    out = bytearray(data[:2])
+    i = 2
+    while i < len(data):
+        marker = data[i + 1]
+        if marker == 0xDA:  # start of scan, the rest is image data
+            out += data[i:]
+            break
+        length = struct.unpack('>H', data[i + 2:i + 4])[0]
+        if not (0xE1 <= marker <= 0xED or marker == 0xFE):
+            out += data[i:i + 2 + length]
+        i += 2 + length
+    return bytes(out)
+
+
+# ---------------------------------------------------------------- emitters
+
+def c_string(text, indent='  '):
+    escaped = text.replace('\\', '\\\\').replace('"', '\\"').replace('\n', '\\n')
+    lines = []
+    while escaped:
+        cut = min(100, len(escaped))
+        # never split an escape sequence
+        while cut < len(escaped) and escaped[cut - 1] == '\\':
+            cut += 1
+        lines.append('%s"%s"' % (indent, escaped[:cut]))
+        escaped = escaped[cut:]
+    return '\n'.join(lines)
+
+
+def c_bytes(data, indent='  '):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+    return '\n'.join(lines)
+
+
+def identifier(path):
+    return re.sub(r'[^a-z0-9]', '_', path.strip('/').lower())
+
+
+# ---------------------------------------------------------------- outputs
+
+def build_config_page(report):
+    source = read('config.html')
+    page = minify_html(source)
+
+    slots = []
+    for match in PLACEHOLDER.finditer(page):
+        slots.append((match.start(), len(match.group(0)), int(match.group(1))))
+    if len(page) > 0xFFFF:
+        sys.exit('config page too large for 16 bit slot offsets')
+
+    report.append(('config page (template)', len(source), len(page), len(page) + 4 * len(slots)))
+
+    out = ['/*', ' ' + GENERATED_NOTE, '', ' Config page template, %d bytes minified from %d bytes of web/config.html.' % (len(page), len(source)),
+           ' config_page_slots lists every {n} placeholder so it can be filled without scanning the page.', ' */', '',
+           '#ifndef PAGE_SLOT_DEFINED', '#define PAGE_SLOT_DEFINED',
+           'struct PageSlot {', '  uint16_t offset;', '  uint8_t  length;', '  uint8_t  id;', '};', '#endif', '',
+           'static const char config_page[] PROGMEM =', c_string(page) + ';', '',
+           '#define CONFIG_PAGE_SLOTS %d' % len(slots),
+           'static const PageSlot config_page_slots[CONFIG_PAGE_SLOTS] PROGMEM = {']
+    for offset, length, slot_id in slots:
+        out.append('  { %d, %d, %d },' % (offset, length, slot_id))
+    out.append('};')
+    write('index.H', '\n'.join(out) + '\n')
+
+
+def build_static_assets(report):
+    blobs = []
+    entries = []
+    for url, name, content_type in STATIC_ASSETS:
+        source = read(name, 'rb')
+        data = strip_jpeg(source) if content_type == 'image/jpeg' else source
+        packed = gzip.compress(data, 9, mtime=0)
+        gzipped = len(packed) < len(data)
+        if not gzipped:
+            packed = data
+        etag = hashlib.sha1(packed).hexdigest()[:16]
+        var = identifier(url)
+        report.append((url + (' (gzip)' if gzipped else ''), len(source), len(data), len(packed)))
+
+        blobs.append('// %s: %d bytes source, %d bytes %s\nstatic const uint8_t %s[] PROGMEM = {\n%s\n};\n'
+                     % (name, len(source), len(packed), 'gzipped' if gzipped else 'stored', var, c_bytes(packed)))
+        entries.append('  { "%s", "%s", "\\"%s\\"", %s, sizeof(%s), %s },'
+                       % (url, content_type, etag, var, var, 'true' if gzipped else 'false'))
+
+    out = ['/*', ' ' + GENERATED_NOTE, '', ' Static asset blobs, included by StaticAssets.cpp only.', ' */', '']
+    out += blobs
+    out.append('#define STATIC_ASSET_ENTRIES \\')
+    out.append(' \\\n'.join(entries))
+    write('src/StaticAssetsData.h', '\n'.join(out) + '\n')
+
+
+def build_portal_assets(report):
+    css = read('portal.css')
+    js = read('portal.js')
+    style = '<style>%s</style>' % minify_css(css)
+    script = '<script>%s</script>' % minify_js(js)
+    report.append(('portal stylesheet', len(css), len(style), len(style) + 1))
+    report.append(('portal script', len(js), len(script), len(script) + 1))
+
+    out = ['/*', ' ' + GENERATED_NOTE, '', ' Stylesheet and script of the WiFiManager portal pages.', ' */', '',
+           '#ifndef WiFiManagerAssets_h', '#define WiFiManagerAssets_h', '',
+           'const char HTTP_STYLE[] PROGMEM  =', c_string(style) + ';', '',
+           'const char HTTP_SCRIPT[] PROGMEM =', c_string(script) + ';', '',
+           '#endif']
+    write('src/WiFiManagerAssets.h', '\n'.join(out) + '\n')
+
+
+def format_report(report):
+    lines = ['%-28s %10s %10s %10s' % ('asset', 'source', 'minified', 'flash')]
+    for name, source, minified, flash in report:
+        lines.append('%-28s %10d %10d %10d' % (name, source, minified, flash))
+    lines.append('%-28s %10d %10s %10d' % ('total', sum(r[1] for r in report), '', sum(r[3] for r in report)))
+    return lines
+
+
+def main():
+    report = []
+    build_static_assets(report)
+    build_portal_assets(report)
+    build_config_page(report)
+
+    # the flash usage report goes to the console and into the header of index.H
+    lines = format_report(report)
+    print('\n'.join(lines))
+    path = os.path.join(ROOT, 'index.H')
+    with open(path) as f:
+        page = f.read()
+    note = ' Flash usage of the generated web assets (bytes):\n\n' + '\n'.join('   ' + l for l in lines) + '\n */'
+    write('index.H', page.replace(' */', '\n' + note, 1))
+
+
+if __name__ == '__main__':
+    main()
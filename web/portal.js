@@ -0,0 +1,5 @@
+// copy the clicked network name into the SSID field
+function c(l) {
+  document.getElementById('s').value = l.innerText || l.textContent;
+  document.getElementById('p').focus();
+}